@@ -5,10 +5,11 @@
 #include <QMap>
 #include <QVector>
 #include <QColor>
-#include <tuple>
-#include <functional>
+#include <QFutureWatcher>
+#include <atomic>
 #include "mousezoom.h"
 #include "chartsetting1.h"
+#include "modelsolver01-06.h"
 
 namespace Ui {
 class ModelWidget01_06;
@@ -16,30 +17,27 @@ class ModelWidget01_06;
 
 class QCPTextElement;
 
-// 类型定义: <时间, 压力, 导数>
-using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
-
 class ModelWidget01_06 : public QWidget
 {
     Q_OBJECT
 
 public:
-    enum ModelType {
-        Model_1 = 0, // 无限大 + 变井储
-        Model_2,     // 无限大 + 恒定井储
-        Model_3,     // 封闭边界 + 变井储
-        Model_4,     // 封闭边界 + 恒定井储
-        Model_5,     // 定压边界 + 变井储
-        Model_6      // 定压边界 + 恒定井储
-    };
+    // 使用计算内核 ModelSolver01_06 中定义的枚举
+    using ModelType = ModelSolver01_06::ModelType;
+    static const ModelType Model_1 = ModelSolver01_06::Model_1; // 无限大 + 变井储
+    static const ModelType Model_2 = ModelSolver01_06::Model_2; // 无限大 + 恒定井储
+    static const ModelType Model_3 = ModelSolver01_06::Model_3; // 封闭边界 + 变井储
+    static const ModelType Model_4 = ModelSolver01_06::Model_4; // 封闭边界 + 恒定井储
+    static const ModelType Model_5 = ModelSolver01_06::Model_5; // 定压边界 + 变井储
+    static const ModelType Model_6 = ModelSolver01_06::Model_6; // 定压边界 + 恒定井储
 
     explicit ModelWidget01_06(ModelType type, QWidget *parent = nullptr);
     ~ModelWidget01_06();
 
-    // 设置是否使用高精度 Stehfest 反演 (对应 MATLAB 中的 N=8)
+    // 设置本界面交互计算是否使用高精度 Stehfest 反演 (对应 MATLAB 中的 N=8)
     void setHighPrecision(bool high);
 
-    // 计算理论曲线 (供 FittingWidget 调用)
+    // 计算理论曲线 (转发至计算内核 ModelSolver01_06)
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
     // 获取当前模型名称
@@ -48,6 +46,8 @@ public:
 signals:
     // 计算完成信号
     void calculationCompleted(const QString& modelType, const QMap<QString, double>& params);
+    // 后台计算完成一条曲线 (跨线程，排队连接)
+    void sigCurveFinished(int index, QVector<double> t, QVector<double> p, QVector<double> d);
 
 public slots:
     void onCalculateClicked();
@@ -60,43 +60,49 @@ public slots:
     void onDependentParamsChanged();
     void onShowPointsToggled(bool checked);
 
+private slots:
+    void onCurveFinished(int index, QVector<double> t, QVector<double> p, QVector<double> d);
+    void onCalculationFinished();
+
 private:
+    // 一次计算的全部曲线: 参数按列存放 (每条曲线一组)，各曲线的时间序列可以不同
+    // 自适应采样时 times[i] 只提供时间范围与点数上限
+    struct CalculationPlan {
+        ParameterBatch params;
+        QVector<QVector<double>> times;
+        bool adaptive = false;
+        QStringList legends;
+        QString sensitivityKey;          // 为空表示单条理论曲线
+    };
+
     void initUi();
     void initChart();
     void setupConnections();
-    void runCalculation();
+    CalculationPlan buildCalculationPlan();
+    void runCalculationTask(const CalculationPlan& plan, bool highPrecision);
+    void setCalculating(bool calculating);
 
     // 辅助函数
     QVector<double> parseInput(const QString& text);
     void setInputText(QLineEdit* edit, double value);
     void plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity);
 
-    // 数学计算核心 (Stehfest 反演循环)
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                             QVector<double>& outPD, QVector<double>& outDeriv);
-
-    // 拉普拉斯空间解 (复合模型通用入口)
-    double flaplace_composite(double z, const QMap<QString, double>& p);
-
-    // PWD 核心计算 (包含边界条件处理 Logic from MATLAB PWD_inf)
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type);
-
-    // 数学工具函数 (对应 MATLAB 内置函数或逻辑)
-    double scaled_besseli(int v, double x); // 缩放 Bessel I
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
-
 private:
     Ui::ModelWidget01_06 *ui;
     MouseZoom* m_plot;
     QCPTextElement* m_plotTitle;
     ModelType m_type;
+    ModelSolver01_06 m_solver;   // 无界面计算内核
     bool m_highPrecision;
     QList<QColor> m_colorList;
 
+    // 异步计算状态
+    CalculationPlan m_plan;                // 当前计算 (界面线程持有)
+    std::atomic<bool> m_cancelRequested;   // 界面线程写入，计算线程与模型计算读取
+    std::atomic<int> m_kernelCalls;        // 已完成曲线的核函数调用次数
+    int m_finishedCurves;
+    QFutureWatcher<void> m_watcher;
+
     // 缓存结果
     QVector<double> res_tD;
     QVector<double> res_pD;
@@ -17,6 +17,13 @@ QMAKE_CXXFLAGS += -O3
 QMAKE_CXXFLAGS_RELEASE -= -O2
 QMAKE_CXXFLAGS_RELEASE += -O3
 
+# 可选: Bessel 函数批量计算启用 AVX2 向量化 (qmake CONFIG+=avx2_bessel)
+# 启用后要求运行机器支持 AVX2/FMA；未启用时使用标量实现
+avx2_bessel {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2 -mfma
+}
+
 # [关键配置] 设置生成的 .exe 文件图标
 # 警告：如果 Resource/PWT.ico 文件不存在，编译将报错 Error 1
 win32: RC_ICONS = Resource/PWT.ico
@@ -27,21 +34,32 @@ win32: LIBS += -lm
 
 # Input
 HEADERS += dataeditorwidget.h \
+           besselbatch.h \
+           besselintegral.h \
            chartsetting1.h \
            chartsetting2.h \
            datacalculate.h \
            datacolumndialog.h \
            dataimportdialog.h \
+           dualnumber.h \
            fittingdatadialog.h \
+           fittingdatareducer.h \
            fittingpage.h \
            fittingparameterchart.h \
+           incrementalderivative.h \
+           derivativesmoother.h \
+           superpositiontime.h \
+           laplacecache.h \
+           laplaceinversion.h \
            modelmanager.h \
            modelparameter.h \
            modelselect.h \
+           modelsolver01-06.h \
            modelwidget01-06.h \
            mousezoom.h \
            newprojectdialog.h \
            paramselectdialog.h \
+           parallelfor.h \
            mainwindow.h \
            monitorbtn.h \
            monitostatew.h \
@@ -56,6 +74,8 @@ HEADERS += dataeditorwidget.h \
            pressurederivativecalculator1.h \
            settingswidget.h \
            qcustomplot.h \
+           typecurvedatabase.h \
+           typecurvematcher.h \
            wt_fittingwidget.h \
            wt_plottingwidget.h \
            wt_projectwidget.h
@@ -87,6 +107,8 @@ FORMS += dataeditorwidget.ui \
          wt_projectwidget.ui
 
 SOURCES += \
+           besselbatch.cpp \
+           besselintegral.cpp \
            chartsetting1.cpp \
            chartsetting2.cpp \
            datacalculate.cpp \
@@ -94,15 +116,23 @@ SOURCES += \
            dataeditorwidget.cpp \
            dataimportdialog.cpp \
            fittingdatadialog.cpp \
+           fittingdatareducer.cpp \
            fittingpage.cpp \
            fittingparameterchart.cpp \
+           incrementalderivative.cpp \
+           derivativesmoother.cpp \
+           superpositiontime.cpp \
+           laplacecache.cpp \
+           laplaceinversion.cpp \
            modelmanager.cpp \
            modelparameter.cpp \
            modelselect.cpp \
+           modelsolver01-06.cpp \
            modelwidget01-06.cpp \
            mousezoom.cpp \
            newprojectdialog.cpp \
            paramselectdialog.cpp \
+           parallelfor.cpp \
            main.cpp \
            mainwindow.cpp \
            monitorbtn.cpp \
@@ -118,6 +148,8 @@ SOURCES += \
            pressurederivativecalculator1.cpp \
            settingswidget.cpp \
            qcustomplot.cpp \
+           typecurvedatabase.cpp \
+           typecurvematcher.cpp \
            wt_fittingwidget.cpp \
            wt_plottingwidget.cpp \
            wt_projectwidget.cpp
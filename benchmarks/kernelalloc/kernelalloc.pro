@@ -0,0 +1,11 @@
+######################################################################
+# 核函数堆分配计数基准 (控制台程序)
+# 构建: qmake kernelalloc.pro && make (Windows 下为 nmake / mingw32-make)
+# 运行: kernelalloc [--points P] [--N N]
+# 说明: Linux (glibc) 下同时统计 malloc 与 operator new；其他平台只统计 operator new
+######################################################################
+include(../solver.pri)
+
+TARGET = kernelalloc
+
+SOURCES += main.cpp
@@ -0,0 +1,174 @@
+/*
+ * main.cpp (benchmarks/kernelalloc)
+ * 文件作用：核函数堆分配计数基准
+ * 功能描述：
+ * 1. 替换全局 operator new / delete 统计分配次数；glibc 下另外拦截 malloc / calloc / realloc
+ *    (Eigen 动态矩阵与 QVector 的存储直接调用 malloc)，此时 operator new 经由 malloc 计数，不重复统计
+ * 2. 单线程、关闭拉普拉斯空间插值缓存，同一组参数分别计算 P 点与 2P 点的曲线，
+ *    两次的分配次数之差除以核函数调用次数之差即为每次核函数调用的分配次数 (曲线级的固定开销相互抵消)
+ * 3. 覆盖模型 1/3/5，nf = 1..8 (定长特化) 与 nf = 10 (动态尺寸回退)，同时输出单次调用的平均用时
+ * 4. 与 kernelbench 一样只使用长期不变的接口，可放到较早的版本上编译对比
+ */
+
+#include "modelsolver01-06.h"
+#include "parallelfor.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long long> g_allocations(0);
+
+void countAllocation()
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+const bool COUNTS_MALLOC = true;
+#else
+const bool COUNTS_MALLOC = false;
+#endif
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+void* operator new(std::size_t size)
+{
+    if (!COUNTS_MALLOC) countAllocation();
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 与 kernelbench 相同的基准参数，裂缝条数由 nf 指定
+QMap<QString, double> benchmarkParams(ModelSolver01_06::ModelType type, int nf, int stehfestN)
+{
+    QMap<QString, double> p;
+    p.insert("phi", 0.05);
+    p.insert("h", 20.0);
+    p.insert("mu", 0.5);
+    p.insert("B", 1.05);
+    p.insert("Ct", 5e-4);
+    p.insert("q", 5.0);
+    p.insert("nf", nf);
+    p.insert("kf", 1e-3);
+    p.insert("km", 1e-4);
+    p.insert("L", 1000.0);
+    p.insert("Lf", 100.0);
+    p.insert("LfD", 0.1);
+    p.insert("rmD", 4.0);
+    p.insert("omega1", 0.4);
+    p.insert("omega2", 0.08);
+    p.insert("lambda1", 1e-3);
+    p.insert("gamaD", 0.02);
+    bool storage = ModelSolver01_06::hasWellboreStorage(type);
+    p.insert("cD", storage ? 0.01 : 0.0);
+    p.insert("S", storage ? 1.0 : 0.0);
+    if (!ModelSolver01_06::isInfiniteBoundary(type)) p.insert("reD", 10.0);
+    p.insert("N", stehfestN);
+    p.insert("LaplaceCache", 0.0);
+    return p;
+}
+
+int optionValue(const QStringList& args, const QString& name, int defaultValue)
+{
+    int i = args.indexOf(name);
+    return (i >= 0 && i + 1 < args.size()) ? args[i + 1].toInt() : defaultValue;
+}
+
+QVector<double> logTimes(int points)
+{
+    QVector<double> t(points);
+    for (int i = 0; i < points; ++i) t[i] = std::pow(10.0, -3.0 + 6.0 * i / (points - 1));
+    return t;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    int points = qMax(2, optionValue(args, "--points", 1000));
+    int stehfestN = optionValue(args, "--N", 12);
+    ParallelFor::pool()->setMaxThreadCount(1);
+
+    const QVector<double> shortTime = logTimes(points);
+    const QVector<double> longTime = logTimes(2 * points);
+    const int nfValues[] = { 1, 2, 3, 4, 5, 6, 7, 8, 10 };
+
+    std::printf("points=%d/%d N=%d 单线程 (插值缓存关闭，%s)\n", points, 2 * points, stehfestN,
+                COUNTS_MALLOC ? "统计 malloc 与 operator new" : "只统计 operator new");
+    std::printf("%-6s %4s %10s %10s %14s %14s\n", "模型", "nf", "增加调用", "增加分配", "分配/次调用", "单次调用(us)");
+
+    for (int m = ModelSolver01_06::Model_1; m <= ModelSolver01_06::Model_5; m += 2) {
+        ModelSolver01_06::ModelType type = (ModelSolver01_06::ModelType)m;
+        ModelSolver01_06 solver(type);
+        for (int nf : nfValues) {
+            QMap<QString, double> params = benchmarkParams(type, nf, stehfestN);
+            int callsShort = 0, callsLong = 0;
+            solver.calculateTheoreticalCurve(params, shortTime, true, &callsShort); // 预热 (系数表等一次性分配)
+
+            long long before = g_allocations.load();
+            solver.calculateTheoreticalCurve(params, shortTime, true, &callsShort);
+            long long allocShort = g_allocations.load() - before;
+
+            QElapsedTimer timer;
+            timer.start();
+            before = g_allocations.load();
+            solver.calculateTheoreticalCurve(params, longTime, true, &callsLong);
+            long long allocLong = g_allocations.load() - before;
+            double elapsedUs = timer.nsecsElapsed() * 1e-3;
+
+            int calls = callsLong - callsShort;
+            long long allocs = allocLong - allocShort;
+            std::printf("%-6d %4d %10d %10lld %14.3f %14.3f\n", m + 1, nf, calls, allocs,
+                        calls > 0 ? double(allocs) / calls : 0.0, callsLong > 0 ? elapsedUs / callsLong : 0.0);
+        }
+    }
+    return 0;
+}
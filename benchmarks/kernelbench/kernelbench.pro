@@ -0,0 +1,10 @@
+######################################################################
+# 拉普拉斯空间核函数微基准 (控制台程序)
+# 构建: qmake kernelbench.pro && make (Windows 下为 nmake / mingw32-make)
+# 运行: kernelbench [--points P] [--N N] [--repeat R] [--threads T]
+######################################################################
+include(../solver.pri)
+
+TARGET = kernelbench
+
+SOURCES += main.cpp
@@ -0,0 +1,105 @@
+/*
+ * main.cpp (benchmarks/kernelbench)
+ * 文件作用：拉普拉斯空间核函数微基准
+ * 功能描述：
+ * 1. 对 6 个模型各计算一条 P 点理论曲线 (默认 2000 点、Stehfest N=12、关闭拉普拉斯空间插值缓存，
+ *    即每条曲线 24000 次核函数调用)，预热一次后重复 R 次取最短用时
+ * 2. 输出每条曲线的用时与每次核函数调用的平均用时，以及压力与导数之和 (17 位有效数字) 作为校验值，
+ *    只改变计算方式的优化前后校验值应逐位一致
+ * 3. 默认只用 1 个线程 (--threads 0 表示使用模型线程池的默认线程数)，结果反映单次调用的开销
+ * 4. 只使用 calculateTheoreticalCurve 与 ParallelFor::pool() 这类长期不变的接口，
+ *    同一份基准可放到较早的版本上编译，直接对比改动前后的用时
+ */
+
+#include "modelsolver01-06.h"
+#include "parallelfor.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+// 基准参数: 与 ModelManager::getDefaultParameters 的模型默认值一致 (基础物性取常用值)
+QMap<QString, double> benchmarkParams(ModelSolver01_06::ModelType type, int stehfestN)
+{
+    QMap<QString, double> p;
+    p.insert("phi", 0.05);
+    p.insert("h", 20.0);
+    p.insert("mu", 0.5);
+    p.insert("B", 1.05);
+    p.insert("Ct", 5e-4);
+    p.insert("q", 5.0);
+    p.insert("nf", 4.0);
+    p.insert("kf", 1e-3);
+    p.insert("km", 1e-4);
+    p.insert("L", 1000.0);
+    p.insert("Lf", 100.0);
+    p.insert("LfD", 0.1);
+    p.insert("rmD", 4.0);
+    p.insert("omega1", 0.4);
+    p.insert("omega2", 0.08);
+    p.insert("lambda1", 1e-3);
+    p.insert("gamaD", 0.02);
+    bool storage = ModelSolver01_06::hasWellboreStorage(type);
+    p.insert("cD", storage ? 0.01 : 0.0);
+    p.insert("S", storage ? 1.0 : 0.0);
+    if (!ModelSolver01_06::isInfiniteBoundary(type)) p.insert("reD", 10.0);
+    p.insert("N", stehfestN);
+    p.insert("LaplaceCache", 0.0);
+    return p;
+}
+
+int optionValue(const QStringList& args, const QString& name, int defaultValue)
+{
+    int i = args.indexOf(name);
+    return (i >= 0 && i + 1 < args.size()) ? args[i + 1].toInt() : defaultValue;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    int points = qMax(2, optionValue(args, "--points", 2000));
+    int stehfestN = optionValue(args, "--N", 12);
+    int repeat = qMax(1, optionValue(args, "--repeat", 5));
+    int threads = optionValue(args, "--threads", 1);
+    if (threads > 0) ParallelFor::pool()->setMaxThreadCount(threads);
+
+    QVector<double> t(points);
+    for (int i = 0; i < points; ++i) t[i] = std::pow(10.0, -3.0 + 6.0 * i / (points - 1));
+
+    std::printf("points=%d N=%d repeat=%d threads=%d (插值缓存关闭)\n", points, stehfestN, repeat,
+                ParallelFor::pool()->maxThreadCount());
+    std::printf("%-6s %12s %14s %14s   %s\n", "模型", "核函数调用", "曲线用时(ms)", "单次调用(us)", "校验值");
+
+    for (int m = ModelSolver01_06::Model_1; m <= ModelSolver01_06::Model_6; ++m) {
+        ModelSolver01_06::ModelType type = (ModelSolver01_06::ModelType)m;
+        ModelSolver01_06 solver(type);
+        QMap<QString, double> params = benchmarkParams(type, stehfestN);
+
+        int calls = 0;
+        solver.calculateTheoreticalCurve(params, t, true, &calls); // 预热 (线程池、系数表)
+
+        double best = std::numeric_limits<double>::infinity();
+        double checksum = 0.0;
+        for (int r = 0; r < repeat; ++r) {
+            QElapsedTimer timer;
+            timer.start();
+            ModelCurveData curve = solver.calculateTheoreticalCurve(params, t, true, &calls);
+            best = qMin(best, timer.nsecsElapsed() * 1e-6);
+
+            checksum = 0.0;
+            for (double v : std::get<1>(curve)) checksum += v;
+            for (double v : std::get<2>(curve)) checksum += v;
+        }
+        std::printf("%-6d %12d %14.2f %14.3f   %.17g\n", m + 1, calls, best,
+                    calls > 0 ? best * 1e3 / calls : 0.0, checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+######################################################################
+# 基准程序共用的计算内核源文件 (ModelSolver01_06 及其依赖，不含界面代码)
+# 与 WellTest.pro 使用相同的优化选项与 Eigen 路径
+######################################################################
+ROOT = $$PWD/..
+
+QT += core gui
+QT -= widgets
+
+CONFIG += console c++17
+CONFIG -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += $$ROOT
+
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# 与主程序一致: qmake CONFIG+=avx2_bessel 启用 Bessel 函数批量计算的 AVX2 路径
+avx2_bessel {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2 -mfma
+}
+
+unix: LIBS += -lm
+
+HEADERS += $$ROOT/besselbatch.h \
+           $$ROOT/besselintegral.h \
+           $$ROOT/dualnumber.h \
+           $$ROOT/laplacecache.h \
+           $$ROOT/laplaceinversion.h \
+           $$ROOT/modelsolver01-06.h \
+           $$ROOT/parallelfor.h \
+           $$ROOT/pressurederivativecalculator.h
+
+SOURCES += $$ROOT/besselbatch.cpp \
+           $$ROOT/besselintegral.cpp \
+           $$ROOT/laplacecache.cpp \
+           $$ROOT/laplaceinversion.cpp \
+           $$ROOT/modelsolver01-06.cpp \
+           $$ROOT/parallelfor.cpp \
+           $$ROOT/pressurederivativecalculator.cpp
+
+# Eigen 路径与 WellTest.pro 相同；其他机器可在命令行追加 INCLUDEPATH+=<eigen 目录>
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+unix: INCLUDEPATH += /usr/include/eigen3
+
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
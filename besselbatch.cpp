@@ -0,0 +1,293 @@
+/*
+ * besselbatch.cpp
+ * 文件作用：批量 Bessel 函数计算实现文件
+ * 功能描述：
+ * 1. I0/I1: x <= 8 与 x > 8 两段 Chebyshev 展开 (区间划分同 Cephes i0e/i1e)
+ * 2. K0/K1: x <= 2 时 K = 光滑部分 ∓ ln(x/2) I，光滑部分关于 x² 展开；x > 2 时对 4/x 展开
+ * 3. 系数由 50 位精度的 boost::multiprecision 在 Chebyshev 节点上离散余弦变换得到，
+ *    截断至 |c_k| < 1e-18 |c_0|，相对误差约 1e-16
+ * 4. AVX2 路径每次处理 4 个自变量，只对块内实际出现的分段执行 Clenshaw 递推，
+ *    exp/log 只在需要的通道上计算；输出指针为 nullptr 的函数不做计算
+ */
+
+#include "besselbatch.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Chebyshev 系数表: f(t) = Σ c_k T_k(t)
+// exp(-x) I0(x),            x in [0, 8],  t = x/4 - 1
+const double I0_SMALL[30] = {
+     3.38397637204738033e-01, -3.04682672343198402e-01,  1.71620901522208769e-01,
+    -9.49010970480476390e-02,  4.93052842396707117e-02, -2.37374148058994705e-02,
+     1.05464603945949979e-02, -4.32430999505057593e-03,  1.63947561694133574e-03,
+    -5.76375574538582356e-04,  1.88502885095841649e-04, -5.75419501008210397e-05,
+     1.64484480707288956e-05, -4.41673835845875052e-06,  1.11738753912010366e-06,
+    -2.67079385394061193e-07,  6.04699502254191863e-08, -1.30002500998624805e-08,
+     2.65982372468238660e-09, -5.18979560163526271e-10,  9.67580903537323697e-11,
+    -1.72682629144155587e-11,  2.95505266312963988e-12, -4.85644678311192896e-13,
+     7.67618549860493607e-14, -1.16853328779934514e-14,  1.71539128555513307e-15,
+    -2.43127984654795490e-16,  3.33079451882223839e-17, -4.41534164647933951e-18
+};
+
+// exp(-x) I1(x) / x,        x in [0, 8],  t = x/4 - 1
+const double I1_SMALL[30] = {
+     1.26293593221816824e-01, -1.76416518357834062e-01,  1.02643658689847095e-01,
+    -5.29459812080949888e-02,  2.47264490306265163e-02, -1.05640848946261974e-02,
+     4.15642294431288820e-03, -1.51357245063125315e-03,  5.12285956168575759e-04,
+    -1.61760815825896743e-04,  4.78156510755005422e-05, -1.32731636560394359e-05,
+     3.47025130813767845e-06, -8.56872026469545475e-07,  2.00329475355213533e-07,
+    -4.44505912879632805e-08,  9.38153738649577259e-09, -1.88724975172282944e-09,
+     3.62559028155211725e-10, -6.66348972350202712e-11,  1.17361862988909012e-11,
+    -1.98397439776494364e-12,  3.22379336594557476e-13, -5.04218550472791179e-14,
+     7.60068429473540767e-15, -1.10559694773538625e-15,  1.55363195773620054e-16,
+    -2.11142121435816596e-17,  2.77791411276104637e-18, -3.54158177254213615e-19
+};
+
+// sqrt(x) exp(-x) I0(x),    x in [8, ∞),  t = 16/x - 1
+const double I0_LARGE[27] = {
+     4.02245205507054393e-01,  3.36911647825569429e-03,  6.88975834691682454e-05,
+     2.89137052083475665e-06,  2.04891858946906384e-07,  2.26666899049817804e-08,
+     3.39623202570838651e-09,  4.94060238822497006e-10,  1.18891471078464390e-11,
+    -3.14991652796324165e-11, -1.32158118404477133e-11, -1.79417853150680615e-12,
+     7.18012445138366601e-13,  3.85277838274214259e-13,  1.54008621752140996e-14,
+    -4.15056934728722224e-14, -9.55484669882830731e-15,  3.81168066935262240e-15,
+     1.77256013305652631e-15, -3.42548561967721900e-16, -2.82762398051658365e-16,
+     3.46122286769746122e-17,  4.46562142029675975e-17, -4.83050448594418188e-18,
+    -7.23318048787475380e-18,  9.92147541217369872e-19,  1.19365089084598204e-18
+};
+
+// sqrt(x) exp(-x) I1(x),    x in [8, ∞),  t = 16/x - 1
+const double I1_LARGE[27] = {
+     3.89288117509140053e-01, -9.76109749136146870e-03, -1.10588938762623713e-04,
+    -3.88256480887769059e-06, -2.51223623787020884e-07, -2.63146884688951959e-08,
+    -3.83538038596423700e-09, -5.58974346219658378e-10, -1.89749581235054126e-11,
+     3.25260358301548844e-11,  1.41258074366137819e-11,  2.03562854414708956e-12,
+    -7.19855177624590836e-13, -4.08355111109219740e-13, -2.10154184277266430e-14,
+     4.27244001671195105e-14,  1.04202769841288021e-14, -3.81440307243700754e-15,
+    -1.88035477551078251e-15,  3.30820231092092852e-16,  2.96262899764595008e-16,
+    -3.20952592199342376e-17, -4.65030536848935863e-17,  4.41434832307170765e-18,
+     7.51729631084210521e-18, -9.31417886732688422e-19, -1.24219327519489097e-18
+};
+
+// K0(x) + ln(x/2) I0(x),    x in (0, 2],  t = x²/2 - 1
+const double K0_SMALL[10] = {
+    -2.67663696616951385e-01,  3.44289899924628495e-01,  3.59799365153615006e-02,
+     1.26461541144692598e-03,  2.28621210311945192e-05,  2.53479107902614939e-07,
+     1.90451637722020905e-09,  1.03496952576336253e-11,  4.25981614279108258e-14,
+     1.37446543588075084e-16
+};
+
+// x (K1(x) - ln(x/2) I1(x)), x in (0, 2],  t = x²/2 - 1
+const double K1_SMALL[11] = {
+     7.62650113669473884e-01, -3.53155960776544875e-01, -1.22611180822657151e-01,
+    -6.97572385963986415e-03, -1.73028895751305199e-04, -2.43340614156596836e-06,
+    -2.21338763073472599e-08, -1.41148839263352781e-10, -6.66690169419932948e-13,
+    -2.42744985051936596e-15, -7.02386347938628815e-18
+};
+
+// sqrt(x) exp(x) K0(x),     x in [2, ∞),  t = 4/x - 1
+const double K0_LARGE[25] = {
+     1.22015154103297774e+00, -3.14481013119645020e-02,  1.56988388573005332e-03,
+    -1.28495495816278017e-04,  1.39498137188765002e-05, -1.83175552271911953e-06,
+     2.76681363944501486e-07, -4.66048989768794783e-08,  8.57403401741422527e-09,
+    -1.69753450938906142e-09,  3.57739728140032832e-10, -7.95748924447739648e-11,
+     1.85594911495492645e-11, -4.51459788337451925e-12,  1.14034058820734414e-12,
+    -2.98009692314817842e-13,  8.03289077506837463e-14, -2.22751332674629647e-14,
+     6.34007647627664606e-15, -1.84859337792090710e-15,  5.51205599940433350e-16,
+    -1.67823112575490059e-16,  5.21039177764355432e-17, -1.64758059398426321e-17,
+     5.30043377117733540e-18
+};
+
+// sqrt(x) exp(x) K1(x),     x in [2, ∞),  t = 4/x - 1
+const double K1_LARGE[25] = {
+     1.36031309524222133e+00,  1.03923736576817236e-01, -2.85781685962277921e-03,
+     1.95215518471351620e-04, -1.93619797416608301e-05,  2.40648494783721699e-06,
+    -3.50196060308781256e-07,  5.74108412545004947e-08, -1.03457624656780968e-08,
+     2.01504975519703466e-09, -4.19035475934192542e-10,  9.21831518760531460e-11,
+    -2.12996783842779092e-11,  5.13963967348234321e-12, -1.28917396094982285e-12,
+     3.34841966605224312e-13, -8.97670518201014629e-14,  2.47715442421959878e-14,
+    -7.01983708921476847e-15,  2.03870316623986097e-15, -6.05704727064301766e-16,
+     1.83809357524304548e-16, -5.68946284919364841e-17,  1.79405104788635718e-17,
+    -5.75674448207330252e-18
+};
+
+// 分段点
+const double I_SPLIT = 8.0;
+const double K_SPLIT = 2.0;
+
+template <int N>
+inline double clenshaw(const double (&c)[N], double t)
+{
+    double t2 = 2.0 * t;
+    double b1 = 0.0, b2 = 0.0;
+    for (int k = N - 1; k >= 1; --k) {
+        double b0 = t2 * b1 - b2 + c[k];
+        b2 = b1;
+        b1 = b0;
+    }
+    return t * b1 - b2 + c[0];
+}
+
+// 需要计算的函数 (未请求的一阶函数跳过其 Chebyshev 递推)
+struct Request {
+    bool i1;
+    bool k0;
+    bool k1;
+};
+
+inline void evaluateOne(double x, const Request& req, double& i0s, double& i1s, double& k0s, double& k1s)
+{
+    double sx = std::sqrt(x);
+    bool needI1 = req.i1 || (req.k1 && x <= K_SPLIT);
+
+    if (x <= I_SPLIT) {
+        double t = 0.25 * x - 1.0;
+        i0s = clenshaw(I0_SMALL, t);
+        i1s = needI1 ? x * clenshaw(I1_SMALL, t) : 0.0;
+    } else {
+        double t = 16.0 / x - 1.0;
+        i0s = clenshaw(I0_LARGE, t) / sx;
+        i1s = needI1 ? clenshaw(I1_LARGE, t) / sx : 0.0;
+    }
+
+    k0s = k1s = 0.0;
+    if (!req.k0 && !req.k1) return;
+    if (x <= K_SPLIT) {
+        // K0 = P - ln(x/2) I0, K1 = Q/x + ln(x/2) I1，I = exp(x) * 缩放值
+        double t = 0.5 * x * x - 1.0;
+        double ex = std::exp(x);
+        double lx = std::log(0.5 * x);
+        double ex2 = ex * ex;
+        if (req.k0) k0s = ex * clenshaw(K0_SMALL, t) - lx * i0s * ex2;
+        if (req.k1) k1s = ex * clenshaw(K1_SMALL, t) / x + lx * i1s * ex2;
+    } else {
+        double t = 4.0 / x - 1.0;
+        if (req.k0) k0s = clenshaw(K0_LARGE, t) / sx;
+        if (req.k1) k1s = clenshaw(K1_LARGE, t) / sx;
+    }
+}
+
+#if defined(__AVX2__)
+
+template <int N>
+inline __m256d clenshaw4(const double (&c)[N], __m256d t)
+{
+    __m256d t2 = _mm256_add_pd(t, t);
+    __m256d b1 = _mm256_setzero_pd();
+    __m256d b2 = _mm256_setzero_pd();
+    for (int k = N - 1; k >= 1; --k) {
+        __m256d b0 = _mm256_add_pd(_mm256_fmsub_pd(t2, b1, b2), _mm256_set1_pd(c[k]));
+        b2 = b1;
+        b1 = b0;
+    }
+    return _mm256_add_pd(_mm256_fmsub_pd(t, b1, b2), _mm256_set1_pd(c[0]));
+}
+
+// 一次处理 4 个自变量
+inline void evaluateFour(const double* px, const Request& req, double* i0s, double* i1s, double* k0s, double* k1s)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d x = _mm256_loadu_pd(px);
+    __m256d sx = _mm256_sqrt_pd(x);
+
+    __m256d smallI = _mm256_cmp_pd(x, _mm256_set1_pd(I_SPLIT), _CMP_LE_OQ);
+    __m256d smallK = _mm256_cmp_pd(x, _mm256_set1_pd(K_SPLIT), _CMP_LE_OQ);
+    int maskI = _mm256_movemask_pd(smallI);
+    int maskK = _mm256_movemask_pd(smallK);
+    bool needI1 = req.i1 || (req.k1 && maskK != 0);
+
+    // I0 / I1
+    __m256d vi0 = _mm256_setzero_pd(), vi1 = _mm256_setzero_pd();
+    if (maskI != 0) {
+        __m256d t = _mm256_fmsub_pd(_mm256_set1_pd(0.25), x, one);
+        vi0 = clenshaw4(I0_SMALL, t);
+        if (needI1) vi1 = _mm256_mul_pd(x, clenshaw4(I1_SMALL, t));
+    }
+    if (maskI != 0xF) {
+        __m256d t = _mm256_sub_pd(_mm256_div_pd(_mm256_set1_pd(16.0), x), one);
+        vi0 = _mm256_blendv_pd(_mm256_div_pd(clenshaw4(I0_LARGE, t), sx), vi0, smallI);
+        if (needI1) vi1 = _mm256_blendv_pd(_mm256_div_pd(clenshaw4(I1_LARGE, t), sx), vi1, smallI);
+    }
+
+    // K0 / K1
+    __m256d vk0 = _mm256_setzero_pd(), vk1 = _mm256_setzero_pd();
+    if (!req.k0 && !req.k1) maskK = -1; // 不需要 K 函数，跳过以下两段
+    else if (maskK != 0) {
+        // exp/log 只在 x <= 2 的通道上计算，其余通道填充无害值
+        alignas(32) double ex[4], lx[4];
+        for (int l = 0; l < 4; ++l) {
+            bool use = (maskK >> l) & 1;
+            ex[l] = use ? std::exp(px[l]) : 1.0;
+            lx[l] = use ? std::log(0.5 * px[l]) : 0.0;
+        }
+        __m256d vex = _mm256_load_pd(ex);
+        __m256d vlx = _mm256_load_pd(lx);
+        __m256d ex2 = _mm256_mul_pd(vex, vex);
+        __m256d xs = _mm256_blendv_pd(one, x, smallK);
+        __m256d t = _mm256_fmsub_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), xs), xs, one);
+        if (req.k0) {
+            __m256d p = clenshaw4(K0_SMALL, t);
+            vk0 = _mm256_fnmadd_pd(_mm256_mul_pd(vlx, vi0), ex2, _mm256_mul_pd(vex, p));
+        }
+        if (req.k1) {
+            __m256d q = clenshaw4(K1_SMALL, t);
+            vk1 = _mm256_fmadd_pd(_mm256_mul_pd(vlx, vi1), ex2, _mm256_div_pd(_mm256_mul_pd(vex, q), xs));
+        }
+    }
+    if ((maskK & 0xF) != 0xF) {
+        __m256d t = _mm256_sub_pd(_mm256_div_pd(_mm256_set1_pd(4.0), x), one);
+        if (req.k0) vk0 = _mm256_blendv_pd(_mm256_div_pd(clenshaw4(K0_LARGE, t), sx), vk0, smallK);
+        if (req.k1) vk1 = _mm256_blendv_pd(_mm256_div_pd(clenshaw4(K1_LARGE, t), sx), vk1, smallK);
+    }
+
+    if (i0s) _mm256_storeu_pd(i0s, vi0);
+    if (i1s) _mm256_storeu_pd(i1s, vi1);
+    if (k0s) _mm256_storeu_pd(k0s, vk0);
+    if (k1s) _mm256_storeu_pd(k1s, vk1);
+}
+
+#endif
+
+} // namespace
+
+void BesselBatch::evaluateScaled(const double* x, int n,
+                                 double* i0s, double* i1s, double* k0s, double* k1s)
+{
+    const Request req = { i1s != nullptr, k0s != nullptr, k1s != nullptr };
+    int k = 0;
+#if defined(__AVX2__)
+    for (; k + 4 <= n; k += 4) {
+        evaluateFour(x + k, req,
+                     i0s ? i0s + k : nullptr, i1s ? i1s + k : nullptr,
+                     k0s ? k0s + k : nullptr, k1s ? k1s + k : nullptr);
+    }
+#endif
+    for (; k < n; ++k) {
+        double a, b, c, d;
+        evaluateOne(x[k], req, a, b, c, d);
+        if (i0s) i0s[k] = a;
+        if (i1s) i1s[k] = b;
+        if (k0s) k0s[k] = c;
+        if (k1s) k1s[k] = d;
+    }
+}
+
+void BesselBatch::evaluateScaled(double x, double& i0s, double& i1s, double& k0s, double& k1s)
+{
+    evaluateOne(x, Request{ true, true, true }, i0s, i1s, k0s, k1s);
+}
+
+bool BesselBatch::simdEnabled()
+{
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,28 @@
+/*
+ * besselbatch.h
+ * 文件作用：批量 Bessel 函数计算头文件
+ * 功能描述：
+ * 1. 对一组自变量同时计算指数缩放的 I0、I1、K0、K1:
+ *    exp(-x)I0(x), exp(-x)I1(x), exp(x)K0(x), exp(x)K1(x)
+ * 2. 采用分段 Chebyshev 展开 (系数由高精度计算离线生成)，同一自变量的四个函数共用 exp/log/sqrt
+ * 3. 编译器开启 AVX2 时 (qmake CONFIG+=avx2_bessel) 每次处理 4 个自变量，否则使用标量实现，结果一致
+ */
+
+#ifndef BESSELBATCH_H
+#define BESSELBATCH_H
+
+class BesselBatch
+{
+public:
+    // 批量计算 n 个自变量 (x > 0)，不需要的输出可传 nullptr
+    static void evaluateScaled(const double* x, int n,
+                               double* i0s, double* i1s, double* k0s, double* k1s);
+
+    // 单个自变量的便捷接口
+    static void evaluateScaled(double x, double& i0s, double& i1s, double& k0s, double& k1s);
+
+    // 当前编译是否启用了 AVX2 向量化路径
+    static bool simdEnabled();
+};
+
+#endif // BESSELBATCH_H
@@ -0,0 +1,164 @@
+/*
+ * besselintegral.cpp
+ * 文件作用：线源积分核 (K0 / I0 沿裂缝段的积分) 实现文件
+ * 功能描述：
+ * 1. ∫0^x K0: K0(t) = Σ (t/2)^2k/(k!)^2 [H_k - γ - ln(t/2)]，逐项积分得
+ *    Σ x(x/2)^2k/((k!)^2(2k+1)) [H_k - γ - ln(x/2) + 1/(2k+1)]，x <= 2 时使用
+ * 2. Ki1(x) = ∫0^∞ exp(-x cosh u)/cosh u du，被积函数在 |Im u| < π/2 内解析，
+ *    梯形公式误差随步长指数下降，x > 2 时约 15 个节点即可达到机器精度
+ * 3. ∫0^x I0 = Σ x(x/2)^2k/((k!)^2(2k+1))，x > 40 时改用渐近展开
+ *    exp(x)/sqrt(2πx) Σ b_m x^-m，b_m = Σ_k a_k (1/2+k)_(m-k)，a_k 为 I0 渐近展开系数
+ */
+
+#include "besselintegral.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+const double EULER_GAMMA = 0.57721566490153286061;
+
+// 幂级数与积分表示之间的切换点
+const double K0_SERIES_LIMIT = 2.0;
+const double I0_SERIES_LIMIT = 40.0;
+
+// ∫I0 渐近展开系数 b_m (首次使用时生成，之后只读)
+const std::vector<double>& integralI0AsymptoticCoefficients()
+{
+    static const std::vector<double> s_coeffs = []() {
+        const int terms = 30;
+        std::vector<double> a(terms), b(terms, 0.0);
+        a[0] = 1.0;
+        for (int k = 1; k < terms; ++k) a[k] = a[k - 1] * (2.0 * k - 1.0) * (2.0 * k - 1.0) / (8.0 * k);
+        for (int m = 0; m < terms; ++m) {
+            for (int k = 0; k <= m; ++k) {
+                double poch = 1.0;
+                for (int i = 0; i < m - k; ++i) poch *= (k + 0.5 + i);
+                b[m] += a[k] * poch;
+            }
+        }
+        return b;
+    }();
+    return s_coeffs;
+}
+
+} // namespace
+
+double BesselIntegral::integralK0Series(double x)
+{
+    if (x <= 0.0) return 0.0;
+    double q = 0.25 * x * x;
+    double logTerm = EULER_GAMMA + std::log(0.5 * x);
+    double base = x;      // x (x/2)^2k / (k!)^2
+    double harmonic = 0.0; // H_k
+    double sum = 0.0;
+    for (int k = 0; k < 60; ++k) {
+        if (k > 0) {
+            base *= q / (double(k) * k);
+            harmonic += 1.0 / k;
+        }
+        double inv = 1.0 / (2.0 * k + 1.0);
+        double term = base * inv * (harmonic - logTerm + inv);
+        sum += term;
+        if (std::abs(term) < 1e-17 * std::abs(sum)) break;
+    }
+    return sum;
+}
+
+double BesselIntegral::bickleyKi1Scaled(double x)
+{
+    // exp(x) Ki1(x) = ∫0^∞ exp(-2x sinh²(u/2)) / cosh u du
+    // 大 x 时被积函数宽度约 1/sqrt(x)，步长随之缩小以保持误差 < exp(-36)
+    double h = std::min(0.25, 0.7 / std::sqrt(x));
+    double sum = 0.5;
+    for (int k = 1; k < 400; ++k) {
+        double u = k * h;
+        double sh = std::sinh(0.5 * u);
+        double e = 2.0 * x * sh * sh;
+        if (e > 40.0) break;
+        sum += std::exp(-e) / std::cosh(u);
+    }
+    return h * sum;
+}
+
+double BesselIntegral::integralI0Series(double x)
+{
+    if (x <= 0.0) return 0.0;
+    double q = 0.25 * x * x;
+    double base = x;
+    double sum = x;
+    for (int k = 1; k < 200; ++k) {
+        base *= q / (double(k) * k);
+        double term = base / (2.0 * k + 1.0);
+        sum += term;
+        if (term < 1e-17 * sum) break;
+    }
+    return sum;
+}
+
+double BesselIntegral::integralK0(double x)
+{
+    if (x <= K0_SERIES_LIMIT) return integralK0Series(x);
+    return 0.5 * M_PI - bickleyKi1(x);
+}
+
+double BesselIntegral::bickleyKi1(double x)
+{
+    if (x <= K0_SERIES_LIMIT) return 0.5 * M_PI - integralK0Series(x);
+    return std::exp(-x) * bickleyKi1Scaled(x);
+}
+
+double BesselIntegral::integralI0Scaled(double x)
+{
+    if (x <= 0.0) return 0.0;
+    if (x <= I0_SERIES_LIMIT) return std::exp(-x) * integralI0Series(x);
+
+    // 渐近展开: 取到项开始增大或可忽略为止
+    const std::vector<double>& b = integralI0AsymptoticCoefficients();
+    double inv = 1.0 / x;
+    double power = 1.0;
+    double sum = 0.0;
+    double lastTerm = 1e300;
+    for (double bm : b) {
+        double term = bm * power;
+        if (term > lastTerm) break;
+        sum += term;
+        if (term < 1e-17 * sum) break;
+        lastTerm = term;
+        power *= inv;
+    }
+    return sum / std::sqrt(2.0 * M_PI * x);
+}
+
+double BesselIntegral::segmentK0(double lo, double hi)
+{
+    if (hi <= lo) return 0.0;
+    if (hi <= 0.0) return segmentK0(-hi, -lo);
+    if (lo < 0.0) {
+        // 跨过奇点: 拆成 [lo, 0] 与 [0, hi] 两段
+        return integralK0(-lo) + integralK0(hi);
+    }
+    // 两端同号: 小自变量用 ∫0^x 相减，大自变量用 Ki1 相减，均避免相近大数相消
+    if (hi <= K0_SERIES_LIMIT) return integralK0Series(hi) - integralK0Series(lo);
+    return bickleyKi1(lo) - bickleyKi1(hi);
+}
+
+double BesselIntegral::segmentI0(double lo, double hi, double shift)
+{
+    if (hi <= lo) return 0.0;
+    if (hi <= 0.0) return segmentI0(-hi, -lo, shift);
+
+    // exp(-shift) ∫0^|u| I0 = integralI0Scaled(|u|) * exp(|u| - shift)
+    auto primitive = [shift](double u) -> double {
+        double v = integralI0Scaled(u);
+        return (v > 0.0) ? v * std::exp(u - shift) : 0.0;
+    };
+    if (lo < 0.0) return primitive(-lo) + primitive(hi);
+    return primitive(hi) - primitive(lo);
+}
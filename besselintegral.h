@@ -0,0 +1,42 @@
+/*
+ * besselintegral.h
+ * 文件作用：线源积分核 (K0 / I0 沿裂缝段的积分) 头文件
+ * 功能描述：
+ * 1. 以闭式方法计算 ∫K0(|u|)du 与 ∫I0(|u|)du，替代逐点自适应高斯积分
+ * 2. 小自变量使用幂级数 (含对数奇异项的解析积分)，积分区间跨过 0 时按奇点拆分
+ * 3. 大自变量使用 Bickley-Naylor 函数 Ki1(x) = ∫x^∞ K0(t)dt 的积分表示 (梯形公式，指数收敛)
+ * 4. ∫I0 在大自变量时使用渐近展开，并以 exp(-x) 缩放的形式返回以避免溢出
+ */
+
+#ifndef BESSELINTEGRAL_H
+#define BESSELINTEGRAL_H
+
+class BesselIntegral
+{
+public:
+    // ∫0^x K0(t)dt, x >= 0
+    static double integralK0(double x);
+
+    // Bickley-Naylor 函数 Ki1(x) = ∫x^∞ K0(t)dt, x >= 0
+    static double bickleyKi1(double x);
+
+    // exp(-x) * ∫0^x I0(t)dt, x >= 0
+    static double integralI0Scaled(double x);
+
+    // ∫lo^hi K0(|u|)du, lo <= hi (u = 0 处的对数奇点按区间拆分处理)
+    static double segmentK0(double lo, double hi);
+
+    // exp(-shift) * ∫lo^hi I0(|u|)du, lo <= hi
+    // shift 用于与调用方的指数缩放合并，避免中间结果溢出
+    static double segmentI0(double lo, double hi, double shift);
+
+private:
+    // 幂级数部分 (x 较小时使用)
+    static double integralK0Series(double x);
+    static double integralI0Series(double x);
+
+    // exp(x) * Ki1(x)，积分表示 + 梯形公式 (x 较大时使用)
+    static double bickleyKi1Scaled(double x);
+};
+
+#endif // BESSELINTEGRAL_H
@@ -0,0 +1,249 @@
+/*
+ * derivativesmoother.cpp
+ * 文件作用：压力导数平滑算法实现文件
+ * 功能描述：
+ * 1. 移动平均与 Savitzky-Golay 的滑动和每隔一个窗口宽度重新精确求和一次，
+ *    既限制累积误差，又使第 i 点的结果与计算起点无关 (增量计算与全量计算一致)
+ * 2. 窗口内含 NaN/Inf 时该点按原始定义直接求和，结果与逐点求和相同
+ */
+
+#include "derivativesmoother.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 窗口 [a, b] 内的有限值之和与非有限值个数
+void sumWindow(const double* y, int a, int b, double& sum, int& bad)
+{
+    sum = 0.0;
+    bad = 0;
+    for (int j = a; j <= b; ++j) {
+        if (std::isfinite(y[j])) sum += y[j];
+        else ++bad;
+    }
+}
+
+// Savitzky-Golay 窗口的零、一、二阶矩 (以 c 为中心)
+void sgMoments(const double* y, int c, int h, double& m0, double& m1, double& m2, int& bad)
+{
+    m0 = m1 = m2 = 0.0;
+    bad = 0;
+    for (int j = -h; j <= h; ++j) {
+        double v = y[c + j];
+        if (!std::isfinite(v)) { ++bad; continue; }
+        m0 += v;
+        m1 += j * v;
+        m2 += double(j) * j * v;
+    }
+}
+
+} // namespace
+
+QStringList DerivativeSmoother::methodNames()
+{
+    return QStringList() << "移动平均" << "Savitzky-Golay" << "对数时间 LOWESS";
+}
+
+QVector<double> DerivativeSmoother::smooth(const QVector<double>& t, const QVector<double>& y, Method method, int span)
+{
+    switch (method) {
+    case SavitzkyGolay: return savitzkyGolay(y, span);
+    case LogLowess:     return logLowess(t, y, span);
+    case MovingAverage:
+    default:            return movingAverage(y, span);
+    }
+}
+
+QVector<double> DerivativeSmoother::movingAverage(const QVector<double>& y, int span)
+{
+    int n = y.size();
+    if (n == 0) return QVector<double>();
+    if (span <= 1) return y;
+
+    QVector<double> result(n);
+    movingAverage(y.constData(), n, span, 0, n, result.data());
+    return result;
+}
+
+void DerivativeSmoother::movingAverage(const double* y, int n, int span, int from, int to, double* out)
+{
+    if (span <= 1) {
+        for (int i = from; i < to; ++i) out[i] = y[i];
+        return;
+    }
+    if (span % 2 == 0) span++;
+    int half = (span - 1) / 2;
+
+    double sum = 0.0;
+    int bad = 0;
+    // 从 from 所在的重新求和点开始滑动
+    int i = (from / span) * span;
+    for (; i < to; ++i) {
+        int start = std::max(0, i - half);
+        int end = std::min(n - 1, i + half);
+
+        if (i % span == 0) {
+            sumWindow(y, start, end, sum, bad);
+        } else {
+            int in = i + half;
+            int outIdx = i - half - 1;
+            if (in < n) {
+                if (std::isfinite(y[in])) sum += y[in];
+                else ++bad;
+            }
+            if (outIdx >= 0) {
+                if (std::isfinite(y[outIdx])) sum -= y[outIdx];
+                else --bad;
+            }
+        }
+        if (i < from) continue;
+
+        int count = end - start + 1;
+        if (bad > 0) {
+            double direct = 0.0;
+            for (int j = start; j <= end; ++j) direct += y[j];
+            out[i] = direct / count;
+        } else {
+            out[i] = sum / count;
+        }
+    }
+}
+
+QVector<double> DerivativeSmoother::savitzkyGolay(const QVector<double>& y, int span)
+{
+    int n = y.size();
+    if (span <= 1 || n < 3) return y;
+    if (span % 2 == 0) span++;
+    // 数据不足一个窗口时缩小窗口
+    if (span > n) span = (n % 2 == 0) ? n - 1 : n;
+    int h = (span - 1) / 2;
+
+    // 二次多项式最小二乘的系数只与窗口宽度有关:
+    // β0 = (S4·M0 - S2·M2) / det, β1 = M1 / S2, β2 = (w·M2 - S2·M0) / det
+    const double w = span;
+    const double s2 = double(h) * (h + 1) * (2 * h + 1) / 3.0;
+    const double s4 = double(h) * (h + 1) * (2 * h + 1) * (3.0 * h * h + 3.0 * h - 1.0) / 15.0;
+    const double det = w * s4 - s2 * s2;
+
+    const double* src = y.constData();
+    QVector<double> result(n);
+    double* out = result.data();
+
+    double m0, m1, m2;
+    int bad;
+
+    // 首尾半个窗口: 用首尾窗口的拟合多项式取值
+    auto fitEdge = [&](int c, int first, int last) {
+        sgMoments(src, c, h, m0, m1, m2, bad);
+        double b0 = (s4 * m0 - s2 * m2) / det;
+        double b1 = m1 / s2;
+        double b2 = (w * m2 - s2 * m0) / det;
+        for (int i = first; i <= last; ++i) {
+            double x = i - c;
+            out[i] = (bad > 0) ? std::nan("") : b0 + b1 * x + b2 * x * x;
+        }
+    };
+    fitEdge(h, 0, h - 1);
+    fitEdge(n - 1 - h, n - h, n - 1);
+
+    // 中间各点: 矩随窗口滑动递推
+    for (int c = h; c < n - h; ++c) {
+        if ((c - h) % span == 0) {
+            sgMoments(src, c, h, m0, m1, m2, bad);
+        } else {
+            // 先以上一个中心 c-1 为原点替换首尾两点，再把原点平移到 c
+            double vOut = src[c - h - 1];
+            double vIn = src[c + h];
+            if (std::isfinite(vOut)) {
+                m0 -= vOut;
+                m1 += h * vOut;
+                m2 -= double(h) * h * vOut;
+            } else {
+                --bad;
+            }
+            if (std::isfinite(vIn)) {
+                m0 += vIn;
+                m1 += (h + 1) * vIn;
+                m2 += double(h + 1) * (h + 1) * vIn;
+            } else {
+                ++bad;
+            }
+            m2 = m2 - 2.0 * m1 + m0;
+            m1 = m1 - m0;
+        }
+        out[c] = (bad > 0) ? std::nan("") : (s4 * m0 - s2 * m2) / det;
+    }
+    return result;
+}
+
+QVector<double> DerivativeSmoother::logLowess(const QVector<double>& t, const QVector<double>& y, int span)
+{
+    int n = qMin(t.size(), y.size());
+    QVector<double> result = y;
+    if (span <= 1 || n < 3) return result;
+
+    // 参与平滑的点: t > 0 且 y 有限，按时间排序 (已有序时不排序)
+    QVector<int> order;
+    order.reserve(n);
+    bool sorted = true;
+    for (int i = 0; i < n; ++i) {
+        if (!(t[i] > 0.0) || !std::isfinite(y[i])) continue;
+        if (!order.isEmpty() && t[i] < t[order.last()]) sorted = false;
+        order.append(i);
+    }
+    if (!sorted) {
+        std::stable_sort(order.begin(), order.end(), [&t](int a, int b) { return t[a] < t[b]; });
+    }
+
+    int m = order.size();
+    int k = qMin(span, m);
+    if (k < 3) return result;
+
+    QVector<double> x(m), v(m);
+    for (int j = 0; j < m; ++j) {
+        x[j] = std::log(t[order[j]]);
+        v[j] = y[order[j]];
+    }
+
+    // 邻域过大时等间隔抽取
+    int stride = (k + LOWESS_MAX_POINTS - 1) / LOWESS_MAX_POINTS;
+
+    int lo = 0;
+    for (int i = 0; i < m; ++i) {
+        // k 个最近邻: 窗口 [lo, lo + k) 随 i 单调右移
+        while (lo + k < m && (x[lo + k] - x[i]) < (x[i] - x[lo])) ++lo;
+        int hi = lo + k - 1;
+
+        double dmax = qMax(x[i] - x[lo], x[hi] - x[i]);
+        if (!(dmax > 0.0)) {
+            double s = 0.0;
+            for (int j = lo; j <= hi; ++j) s += v[j];
+            result[order[i]] = s / k;
+            continue;
+        }
+
+        // 三次方权重的局部线性回归 (以 x[i] 为原点，截距即为平滑值)
+        double sw = 0.0, swx = 0.0, swxx = 0.0, swy = 0.0, swxy = 0.0;
+        auto accumulate = [&](int j) {
+            double d = x[j] - x[i];
+            double r = std::fabs(d) / dmax;
+            if (r >= 1.0) return;
+            double u = 1.0 - r * r * r;
+            double wt = u * u * u;
+            sw += wt;
+            swx += wt * d;
+            swxx += wt * d * d;
+            swy += wt * v[j];
+            swxy += wt * d * v[j];
+        };
+        for (int j = lo; j <= hi; j += stride) accumulate(j);
+        if ((i - lo) % stride != 0) accumulate(i);
+
+        double dd = sw * swxx - swx * swx;
+        if (dd > 1e-12 * sw * swxx) result[order[i]] = (swy * swxx - swx * swxy) / dd;
+        else result[order[i]] = swy / sw;
+    }
+    return result;
+}
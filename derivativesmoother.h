@@ -0,0 +1,52 @@
+/*
+ * derivativesmoother.h
+ * 文件作用：压力导数平滑算法头文件
+ * 功能描述：
+ * 1. 移动平均: 前缀和实现，每点 O(1)，边缘处窗口截断 (与原 smoothData 的行为一致)
+ * 2. Savitzky-Golay (二次多项式): 窗口内的零阶、一阶、二阶矩随窗口滑动递推更新，每点 O(1)；
+ *    最小二乘系数只由窗口宽度决定，预先算好；首尾各半个窗口的点按首尾窗口的拟合多项式取值
+ * 3. 对数时间 LOWESS: 在 ln t 上取 span 个最近邻 (有序时间上滑动窗口求得)，三次方权重的局部线性回归；
+ *    邻域点数超过 LOWESS_MAX_POINTS 时等间隔抽取，每点计算量有上界
+ * 4. 三种方法的计算量均与窗口大小无关或有上界 (时间无序时 LOWESS 先排序，n log n)
+ */
+
+#ifndef DERIVATIVESMOOTHER_H
+#define DERIVATIVESMOOTHER_H
+
+#include <QStringList>
+#include <QVector>
+
+class DerivativeSmoother
+{
+public:
+    enum Method {
+        MovingAverage = 0,
+        SavitzkyGolay = 1,
+        LogLowess = 2
+    };
+
+    // 各方法的显示名称 (按枚举顺序，用于下拉框)
+    static QStringList methodNames();
+
+    /**
+     * @brief 统一入口
+     * @param t 时间 (只有 LogLowess 使用)
+     * @param y 待平滑的数据 (通常为导数)
+     * @param method 平滑方法
+     * @param span 窗口点数 (偶数自动加 1)；不大于 1 时原样返回
+     */
+    static QVector<double> smooth(const QVector<double>& t, const QVector<double>& y, Method method, int span);
+
+    static QVector<double> movingAverage(const QVector<double>& y, int span);
+    // 只计算 [from, to) 区间的移动平均 (写入长度为 n 的 out)，用于增量更新
+    static void movingAverage(const double* y, int n, int span, int from, int to, double* out);
+
+    static QVector<double> savitzkyGolay(const QVector<double>& y, int span);
+
+    static QVector<double> logLowess(const QVector<double>& t, const QVector<double>& y, int span);
+
+    // LOWESS 每个邻域参与回归的最多点数
+    static const int LOWESS_MAX_POINTS = 41;
+};
+
+#endif // DERIVATIVESMOOTHER_H
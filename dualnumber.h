@@ -0,0 +1,111 @@
+/*
+ * dualnumber.h
+ * 文件作用：前向自动微分用的多分量对偶数
+ * 功能描述：
+ * 1. 一个对偶数携带函数值与至多 MAX_TANGENTS 个方向导数 (对各参数的偏导数)，
+ *    计算内核以对偶数为标量运行一遍即同时得到函数值和全部偏导数
+ * 2. 方向导数个数在运行时确定；常数的方向导数个数为 0，参与运算时按 0 处理
+ * 3. 提供四则运算与 sqrt/exp/log；比较与分支判断只依据函数值 (primalValue)
+ */
+
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+#include <algorithm>
+
+class DualNumber
+{
+public:
+    static const int MAX_TANGENTS = 16;
+
+    DualNumber() : m_value(0.0), m_count(0) {}
+    DualNumber(double value) : m_value(value), m_count(0) {}
+
+    // 第 index 个自变量 (count 为本次计算的自变量个数)
+    static DualNumber variable(double value, int index, int count) {
+        DualNumber r(value);
+        r.setCount(count);
+        r.m_tangent[index] = 1.0;
+        return r;
+    }
+
+    double value() const { return m_value; }
+    int count() const { return m_count; }
+    double tangent(int k) const { return (k < m_count) ? m_tangent[k] : 0.0; }
+
+    // 设置方向导数个数，新增分量清零
+    void setCount(int count) {
+        for (int k = m_count; k < count; ++k) m_tangent[k] = 0.0;
+        m_count = count;
+    }
+    void setTangent(int k, double d) { m_tangent[k] = d; }
+
+    // r = value，方向导数 ca * a' + cb * b'
+    static DualNumber combine(double value, double ca, const DualNumber& a, double cb, const DualNumber& b) {
+        DualNumber r(value);
+        r.m_count = std::max(a.m_count, b.m_count);
+        if (a.m_count == b.m_count) {
+            for (int k = 0; k < r.m_count; ++k) r.m_tangent[k] = ca * a.m_tangent[k] + cb * b.m_tangent[k];
+        } else {
+            for (int k = 0; k < r.m_count; ++k) r.m_tangent[k] = ca * a.tangent(k) + cb * b.tangent(k);
+        }
+        return r;
+    }
+
+    // r = value，方向导数 c * a'
+    static DualNumber chain(double value, double c, const DualNumber& a) {
+        DualNumber r(value);
+        r.m_count = a.m_count;
+        for (int k = 0; k < r.m_count; ++k) r.m_tangent[k] = c * a.m_tangent[k];
+        return r;
+    }
+
+    DualNumber operator-() const { return chain(-m_value, -1.0, *this); }
+
+    friend DualNumber operator+(const DualNumber& a, const DualNumber& b) { return combine(a.m_value + b.m_value, 1.0, a, 1.0, b); }
+    friend DualNumber operator-(const DualNumber& a, const DualNumber& b) { return combine(a.m_value - b.m_value, 1.0, a, -1.0, b); }
+    friend DualNumber operator*(const DualNumber& a, const DualNumber& b) { return combine(a.m_value * b.m_value, b.m_value, a, a.m_value, b); }
+    friend DualNumber operator/(const DualNumber& a, const DualNumber& b) {
+        double v = a.m_value / b.m_value;
+        return combine(v, 1.0 / b.m_value, a, -v / b.m_value, b);
+    }
+
+    friend DualNumber operator+(const DualNumber& a, double c) { return chain(a.m_value + c, 1.0, a); }
+    friend DualNumber operator+(double c, const DualNumber& a) { return chain(c + a.m_value, 1.0, a); }
+    friend DualNumber operator-(const DualNumber& a, double c) { return chain(a.m_value - c, 1.0, a); }
+    friend DualNumber operator-(double c, const DualNumber& a) { return chain(c - a.m_value, -1.0, a); }
+    friend DualNumber operator*(const DualNumber& a, double c) { return chain(a.m_value * c, c, a); }
+    friend DualNumber operator*(double c, const DualNumber& a) { return chain(c * a.m_value, c, a); }
+    friend DualNumber operator/(const DualNumber& a, double c) { return chain(a.m_value / c, 1.0 / c, a); }
+    friend DualNumber operator/(double c, const DualNumber& a) {
+        double v = c / a.m_value;
+        return chain(v, -v / a.m_value, a);
+    }
+
+    DualNumber& operator+=(const DualNumber& b) { return *this = *this + b; }
+    DualNumber& operator-=(const DualNumber& b) { return *this = *this - b; }
+    DualNumber& operator*=(const DualNumber& b) { return *this = *this * b; }
+    DualNumber& operator/=(const DualNumber& b) { return *this = *this / b; }
+
+    friend DualNumber sqrt(const DualNumber& a) {
+        double v = std::sqrt(a.m_value);
+        return chain(v, 0.5 / v, a);
+    }
+    friend DualNumber exp(const DualNumber& a) {
+        double v = std::exp(a.m_value);
+        return chain(v, v, a);
+    }
+    friend DualNumber log(const DualNumber& a) { return chain(std::log(a.m_value), 1.0 / a.m_value, a); }
+
+private:
+    double m_value;
+    int m_count;
+    double m_tangent[MAX_TANGENTS];
+};
+
+// 标量的函数值部分 (double 与 DualNumber 统一接口，供模板代码中的比较与分支使用)
+inline double primalValue(double x) { return x; }
+inline double primalValue(const DualNumber& x) { return x.value(); }
+
+#endif // DUALNUMBER_H
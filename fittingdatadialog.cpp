@@ -9,6 +9,7 @@
 
 #include "fittingdatadialog.h"
 #include "ui_fittingdatadialog.h"
+#include "derivativesmoother.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
@@ -27,6 +28,8 @@ FittingDataDialog::FittingDataDialog(QStandardItemModel* projectModel, QWidget *
 {
     ui->setupUi(this);
 
+    ui->comboSmoothMethod->addItems(DerivativeSmoother::methodNames());
+
     // 连接信号槽
     connect(ui->radioProjectData, &QRadioButton::toggled, this, &FittingDataDialog::onSourceChanged);
     connect(ui->radioExternalFile, &QRadioButton::toggled, this, &FittingDataDialog::onSourceChanged);
@@ -278,6 +281,7 @@ void FittingDataDialog::onDerivColumnChanged(int index)
 void FittingDataDialog::onSmoothingToggled(bool checked)
 {
     ui->spinSmoothSpan->setEnabled(checked);
+    ui->comboSmoothMethod->setEnabled(checked);
 }
 
 // 获取设置结果
@@ -298,6 +302,7 @@ FittingDataSettings FittingDataDialog::getSettings() const
 
     s.enableSmoothing = ui->checkSmoothing->isChecked();
     s.smoothingSpan = ui->spinSmoothSpan->value();
+    s.smoothingMethod = ui->comboSmoothMethod->currentIndex();
 
     return s;
 }
@@ -31,6 +31,7 @@ struct FittingDataSettings {
 
     bool enableSmoothing;       // 是否启用平滑
     int smoothingSpan;          // 平滑窗口大小 (奇数)
+    int smoothingMethod;        // 平滑方法 (DerivativeSmoother::Method)
 };
 
 class FittingDataDialog : public QDialog
@@ -0,0 +1,92 @@
+/*
+ * fittingdatareducer.cpp
+ * 文件作用：拟合数据抽稀实现文件
+ * 功能描述：
+ * 1. 样本按 (区间号, 时间) 排序后逐区间统计，排序为 O(n log n)，统计为 O(n)
+ * 2. 中位数用 nth_element 求取，偶数个样本时取中间两个的平均
+ */
+
+#include "fittingdatareducer.h"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+double FittingDataReducer::statistic(QVector<double>& values, Statistic stat)
+{
+    int n = values.size();
+    if (n == 0) return 0.0;
+    if (n == 1) return values[0];
+
+    if (stat == Mean) {
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        return sum / n;
+    }
+
+    double* first = values.data();
+    double* mid = first + n / 2;
+    std::nth_element(first, mid, first + n);
+    if (n % 2 != 0) return *mid;
+    double lower = *std::max_element(first, mid);
+    return 0.5 * (lower + *mid);
+}
+
+ReducedFittingData FittingDataReducer::reduce(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d,
+                                              int pointsPerCycle, Statistic stat)
+{
+    ReducedFittingData r;
+    int n = std::min(t.size(), p.size());
+
+    if (pointsPerCycle <= 0) {
+        // 逐元素复制，不与观测数据共享存储 (拟合数据会在多个线程中同时读取，共享时可能引发分离竞争)
+        int nd = std::min((int)d.size(), n);
+        r.time.resize(n);
+        r.pressure.resize(n);
+        r.derivative.resize(nd);
+        std::copy(t.constBegin(), t.constBegin() + n, r.time.begin());
+        std::copy(p.constBegin(), p.constBegin() + n, r.pressure.begin());
+        std::copy(d.constBegin(), d.constBegin() + nd, r.derivative.begin());
+        r.weight.fill(1.0, n);
+        return r;
+    }
+
+    // (区间号, 样本下标)，区间号为 floor(log10(t) * pointsPerCycle)
+    std::vector<std::pair<long long, int>> keys;
+    keys.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (!(t[i] > 0.0) || !std::isfinite(t[i])) continue;
+        keys.emplace_back((long long)std::floor(std::log10(t[i]) * pointsPerCycle), i);
+    }
+    std::sort(keys.begin(), keys.end(), [&t](const std::pair<long long, int>& a, const std::pair<long long, int>& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return t[a.second] < t[b.second];
+    });
+    if (keys.empty()) return r;
+
+    QVector<double> bt, bp, bd;
+    for (size_t begin = 0; begin < keys.size();) {
+        size_t end = begin + 1;
+        while (end < keys.size() && keys[end].first == keys[begin].first) ++end;
+
+        bt.clear(); bp.clear(); bd.clear();
+        for (size_t k = begin; k < end; ++k) {
+            int i = keys[k].second;
+            bt.append(std::log(t[i]));
+            if (p[i] > 1e-10) bp.append(p[i]);
+            if (i < d.size() && d[i] > 1e-10) bd.append(d[i]);
+        }
+
+        r.time.append((end - begin == 1) ? t[keys[begin].second] : std::exp(statistic(bt, stat)));
+        r.pressure.append(statistic(bp, stat));
+        r.derivative.append(statistic(bd, stat));
+        r.weight.append((double)(end - begin));
+        begin = end;
+    }
+
+    // 权重归一化为平均值 1
+    double scale = (double)r.weight.size() / keys.size();
+    for (double& w : r.weight) w *= scale;
+    return r;
+}
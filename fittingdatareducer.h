@@ -0,0 +1,52 @@
+/*
+ * fittingdatareducer.h
+ * 文件作用：拟合数据抽稀头文件
+ * 功能描述：
+ * 1. 将观测时间按对数等分区间 (每个对数周期 pointsPerCycle 个区间)，
+ *    每个区间内的压力与导数取中位数或均值，合并为一个拟合点
+ * 2. 拟合点的时间取区间内时间的中位数或几何平均；只含一个样本的区间原样保留
+ * 3. 每个拟合点记录权重 (区间内样本数，归一化为平均值 1)，
+ *    加权后各时间段在目标函数中的比重与使用全部数据时相同 (区间内的噪声则被平均掉)
+ * 4. 压力或导数不大于 1e-10 的样本视为无效 (与残差计算的判据一致)，不参与该量的统计；
+ *    区间内没有有效值时记为 0，拟合时该点对应的残差为 0
+ */
+
+#ifndef FITTINGDATAREDUCER_H
+#define FITTINGDATAREDUCER_H
+
+#include <QVector>
+
+struct ReducedFittingData
+{
+    QVector<double> time;
+    QVector<double> pressure;
+    QVector<double> derivative;
+    QVector<double> weight;
+};
+
+class FittingDataReducer
+{
+public:
+    enum Statistic {
+        Median = 0,
+        Mean = 1
+    };
+
+    /**
+     * @brief 按对数时间分区抽稀观测数据
+     * @param t 观测时间 (不要求有序，抽稀时 t <= 0 的样本被忽略)
+     * @param p 观测压力
+     * @param d 观测导数 (可短于 t，缺少的部分视为无效)
+     * @param pointsPerCycle 每个对数周期的区间数；不大于 0 时原样返回，权重全为 1
+     * @param stat 区间内的统计方式
+     * @return 按时间递增的抽稀数据
+     */
+    static ReducedFittingData reduce(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d,
+                                     int pointsPerCycle, Statistic stat);
+
+private:
+    // values 会被重排
+    static double statistic(QVector<double>& values, Statistic stat);
+};
+
+#endif // FITTINGDATAREDUCER_H
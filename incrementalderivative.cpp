@@ -0,0 +1,143 @@
+/*
+ * incrementalderivative.cpp
+ * 文件作用：增量压力导数计算实现文件
+ * 功能描述：
+ * 1. 窗口端点、导数公式与平滑均复用 PressureDerivativeCalculator / PressureDerivativeCalculator1 的分步接口，
+ *    保证增量结果与全量计算一致
+ * 2. 追加 m 个点时的计算量为 O(m + 右侧窗口未闭合的点数 + 平滑窗口)，与记录总长度无关
+ */
+
+#include "incrementalderivative.h"
+#include "pressurederivativecalculator.h"
+#include "pressurederivativecalculator1.h"
+
+#include <algorithm>
+#include <cmath>
+
+IncrementalDerivative::IncrementalDerivative(double lSpacing, int smoothSpan, QObject* parent)
+    : QObject(parent)
+    , m_lSpacing(lSpacing)
+    , m_smoothSpan(smoothSpan)
+    , m_first(0)
+    , m_ordered(true)
+    , m_openFrom(0)
+{
+}
+
+void IncrementalDerivative::setLSpacing(double lSpacing)
+{
+    m_lSpacing = lSpacing;
+    update(0);
+}
+
+void IncrementalDerivative::setSmoothSpan(int span)
+{
+    m_smoothSpan = span;
+    update(0);
+}
+
+void IncrementalDerivative::reset(const QVector<double>& t, const QVector<double>& dp)
+{
+    m_t = t;
+    m_p = dp;
+    m_lnT = PressureDerivativeCalculator::logTime(t);
+
+    // 有序性: t <= 0 的点只能出现在开头，其后 ln t 不减
+    int n = m_t.size();
+    const double* x = m_lnT.constData();
+    m_first = 0;
+    while (m_first < n && std::isnan(x[m_first])) ++m_first;
+    m_ordered = true;
+    for (int i = m_first + 1; i < n && m_ordered; ++i) m_ordered = (x[i] >= x[i - 1]);
+
+    update(0);
+}
+
+void IncrementalDerivative::append(const QVector<double>& t, const QVector<double>& dp)
+{
+    if (t.isEmpty()) return;
+    int oldN = m_t.size();
+    m_t += t;
+    m_p += dp;
+    m_lnT += PressureDerivativeCalculator::logTime(t);
+
+    int n = m_t.size();
+    const double* x = m_lnT.constData();
+    for (int i = oldN; i < n && m_ordered; ++i) {
+        if (std::isnan(x[i])) {
+            if (m_first == i) ++m_first;
+            else m_ordered = false;
+        } else if (i > m_first) {
+            m_ordered = (x[i] >= x[i - 1]);
+        }
+    }
+
+    update(m_ordered ? std::min(m_openFrom, oldN) : 0);
+}
+
+void IncrementalDerivative::clear()
+{
+    reset(QVector<double>(), QVector<double>());
+}
+
+void IncrementalDerivative::update(int from)
+{
+    int n = m_t.size();
+    int oldN = m_left.size();
+    const double* x = m_lnT.constData();
+
+    // 1. 窗口端点
+    if (from == 0 || !m_ordered) {
+        from = 0;
+        PressureDerivativeCalculator::findWindowPoints(m_lnT, m_lSpacing, m_left, m_right);
+    } else {
+        m_left.resize(n);
+        m_right.resize(n);
+        int* lo = m_left.data();
+        int* hi = m_right.data();
+
+        // 新点的左端点接着上一点的位置推进
+        for (int i = oldN; i < n; ++i) {
+            lo[i] = -1;
+            hi[i] = -1;
+            if (i < m_first) continue;
+            int l = (i > 0 && lo[i - 1] >= 0) ? lo[i - 1] : m_first - 1;
+            while (l + 1 < i && (x[i] - x[l + 1]) >= m_lSpacing) ++l;
+            if (l >= m_first) lo[i] = l;
+        }
+        // 右侧窗口未闭合的点: 旧数据中没有右端点，从新数据的开头继续寻找
+        int r = oldN;
+        for (int i = std::max(from, m_first); i < n; ++i) {
+            if (r <= i) r = i + 1;
+            while (r < n && !((x[r] - x[i]) >= m_lSpacing)) ++r;
+            hi[i] = (r < n) ? r : -1;
+        }
+    }
+
+    // 右端点随 i 单调，未闭合的点总在末尾
+    m_openFrom = n;
+    if (m_ordered) {
+        for (int i = std::max(from, m_first); i < n; ++i) {
+            if (m_right[i] < 0) { m_openFrom = i; break; }
+        }
+    }
+
+    // 2. 导数
+    m_raw.resize(n);
+    PressureDerivativeCalculator::evaluateBourdetDerivative(m_t.constData(), x, m_p.constData(),
+                                                           m_left.constData(), m_right.constData(),
+                                                           n, from, n, m_raw.data());
+
+    // 3. 平滑: 窗口覆盖到 [from, n) 的点 (含原先在末尾被截断的窗口)
+    int first = from;
+    if (m_smoothSpan > 1) {
+        int span = (m_smoothSpan % 2 == 0) ? m_smoothSpan + 1 : m_smoothSpan;
+        first = std::max(0, from - (span - 1) / 2);
+        m_smoothed.resize(n);
+        PressureDerivativeCalculator1::smoothRange(m_raw, span, first, n, m_smoothed.data());
+    } else {
+        m_smoothed.clear();
+    }
+
+    emit derivativeUpdated(first, n - first);
+}
@@ -0,0 +1,70 @@
+/*
+ * incrementalderivative.h
+ * 文件作用：增量压力导数计算头文件
+ * 功能描述：
+ * 1. 保存一条压力记录的 ln t、各点 L-Spacing 窗口端点与导数，新数据追加在末尾时只重算受影响的尾部
+ * 2. 时间递增时，第 i 点的导数只在其右侧窗口尚未闭合 (右侧还没有距离 ≥ L 的点) 时随追加数据变化，
+ *    这些点总是序列末尾的一段；追加时窗口端点从上次的位置继续双指针推进
+ * 3. 平滑 (移动平均) 同样只重算窗口覆盖到变化区间的点
+ * 4. 结果与对全部数据调用 PressureDerivativeCalculator::calculateBourdetDerivative
+ *    (及 PressureDerivativeCalculator1::smoothData) 相同；追加的数据时间不递增时改为全量重算
+ * 5. 每次更新后发出 derivativeUpdated(first, count)，界面只需刷新这一段
+ */
+
+#ifndef INCREMENTALDERIVATIVE_H
+#define INCREMENTALDERIVATIVE_H
+
+#include <QObject>
+#include <QVector>
+
+class IncrementalDerivative : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IncrementalDerivative(double lSpacing = 0.15, int smoothSpan = 1, QObject* parent = nullptr);
+
+    // 修改设置后全量重算
+    void setLSpacing(double lSpacing);
+    void setSmoothSpan(int span);
+    double lSpacing() const { return m_lSpacing; }
+    int smoothSpan() const { return m_smoothSpan; }
+
+    // 以新的数据替换全部记录
+    void reset(const QVector<double>& t, const QVector<double>& dp);
+    // 在末尾追加数据 (t 与 dp 等长)，只重算受影响的尾部
+    void append(const QVector<double>& t, const QVector<double>& dp);
+    void clear();
+
+    int size() const { return m_t.size(); }
+    const QVector<double>& time() const { return m_t; }
+    const QVector<double>& pressureDrop() const { return m_p; }
+    // 平滑后的导数 (平滑窗口不大于 1 时与 rawDerivative() 相同)
+    const QVector<double>& derivative() const { return m_smoothSpan > 1 ? m_smoothed : m_raw; }
+    const QVector<double>& rawDerivative() const { return m_raw; }
+
+signals:
+    // [first, first + count) 的导数已更新 (包括新追加的点)
+    void derivativeUpdated(int first, int count);
+
+private:
+    // 从 from 起重算窗口端点、导数与平滑结果，并发出更新信号
+    void update(int from);
+
+private:
+    double m_lSpacing;
+    int m_smoothSpan;
+
+    QVector<double> m_t;
+    QVector<double> m_lnT;        // t <= 0 时为 NaN
+    QVector<double> m_p;
+    QVector<int> m_left;          // 左右窗口端点 (不存在时为 -1)
+    QVector<int> m_right;
+    QVector<double> m_raw;
+    QVector<double> m_smoothed;
+
+    int m_first;                  // 第一个 t > 0 的点
+    bool m_ordered;               // 时间是否递增 (t <= 0 的点只在开头)
+    int m_openFrom;               // 从此处起各点的右侧窗口尚未闭合，追加数据后需要重算
+};
+
+#endif // INCREMENTALDERIVATIVE_H
@@ -0,0 +1,171 @@
+/*
+ * laplacecache.cpp
+ * 文件作用：拉普拉斯空间插值缓存实现文件
+ * 功能描述：
+ * 1. 初始每 2 个数量级一段，每段 8 次 Lobatto 插值；节点数按 8 -> 16 -> 32 加倍，
+ *    加倍时偶数号节点即上一轮的全部节点，只需计算新增的奇数号节点
+ * 2. 新增节点处 "旧插值 - 真实值" 的最大值作为该段误差估计 (对加倍后的插值是保守估计)
+ * 3. 32 次仍不满足容差的段二分后重新开始；超出调用预算时缓存无效，由调用方回退逐点计算
+ * 4. 每一轮所有段需要的节点一次交给批量核函数，调用方可在其中并行计算
+ */
+
+#include "laplacecache.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+const double SEGMENT_DECADES = 2.0;
+const int INITIAL_DEGREE = 8;
+const int MAX_DEGREE = 32;
+
+} // namespace
+
+LaplaceSpaceCache::LaplaceSpaceCache()
+    : m_relTol(1e-10)
+    , m_maxKernelCalls(400)
+    , m_uMin(0.0)
+    , m_uMax(0.0)
+    , m_valid(false)
+    , m_kernelCalls(0)
+    , m_estimatedError(0.0)
+{
+}
+
+double LaplaceSpaceCache::lobattoNode(const Segment& s, int j, int n)
+{
+    return 0.5 * (s.a + s.b) + 0.5 * (s.b - s.a) * std::cos(M_PI * j / n);
+}
+
+double LaplaceSpaceCache::interpolate(const Segment& s, double u)
+{
+    // 重心插值: 权重 (-1)^j，两端减半
+    int n = s.values.size() - 1;
+    double x = (2.0 * u - s.a - s.b) / (s.b - s.a);
+    double num = 0.0, den = 0.0;
+    for (int j = 0; j <= n; ++j) {
+        double xj = std::cos(M_PI * j / n);
+        double diff = x - xj;
+        if (diff == 0.0) return s.values[j];
+        double w = (j % 2 == 0) ? 1.0 : -1.0;
+        if (j == 0 || j == n) w *= 0.5;
+        w /= diff;
+        num += w * s.values[j];
+        den += w;
+    }
+    return num / den;
+}
+
+bool LaplaceSpaceCache::build(double zMin, double zMax, const BatchKernel& kernel)
+{
+    m_valid = false;
+    m_kernelCalls = 0;
+    m_estimatedError = 0.0;
+    m_segments.clear();
+    if (!(zMin > 0.0) || !(zMax > zMin) || !std::isfinite(zMax)) return false;
+
+    m_uMin = std::log(zMin);
+    m_uMax = std::log(zMax);
+    int nSeg = std::max(1, (int)std::ceil((m_uMax - m_uMin) / (SEGMENT_DECADES * std::log(10.0))));
+    for (int k = 0; k < nSeg; ++k) {
+        Segment s;
+        s.a = m_uMin + (m_uMax - m_uMin) * k / nSeg;
+        s.b = m_uMin + (m_uMax - m_uMin) * (k + 1) / nSeg;
+        s.error = std::numeric_limits<double>::infinity();
+        s.done = false;
+        m_segments.append(s);
+    }
+
+    for (;;) {
+        // 收集本轮所有待计算节点: 新段取初始节点，未收敛段取加倍后的奇数号节点
+        QVector<double> u;
+        for (int k = 0; k < m_segments.size(); ++k) {
+            const Segment& s = m_segments[k];
+            if (s.done) continue;
+            if (s.values.isEmpty()) {
+                for (int j = 0; j <= INITIAL_DEGREE; ++j) u.append(lobattoNode(s, j, INITIAL_DEGREE));
+            } else {
+                int n2 = 2 * (s.values.size() - 1);
+                for (int j = 1; j < n2; j += 2) u.append(lobattoNode(s, j, n2));
+            }
+        }
+        if (u.isEmpty()) break;
+        if (m_kernelCalls + u.size() > m_maxKernelCalls) return false;
+
+        QVector<double> z(u.size()), p(u.size());
+        for (int i = 0; i < u.size(); ++i) z[i] = std::exp(u[i]);
+        kernel(z.constData(), p.data(), z.size());
+        m_kernelCalls += z.size();
+        for (int i = 0; i < p.size(); ++i) {
+            if (!(p[i] > 0.0) || !std::isfinite(p[i])) return false;
+        }
+
+        // 更新各段
+        QVector<Segment> next;
+        int i = 0;
+        for (int k = 0; k < m_segments.size(); ++k) {
+            Segment s = m_segments[k];
+            if (s.done) { next.append(s); continue; }
+
+            if (s.values.isEmpty()) {
+                for (int j = 0; j <= INITIAL_DEGREE; ++j, ++i) s.values.append(std::log(p[i]));
+                next.append(s);
+                continue;
+            }
+
+            int n = s.values.size() - 1;
+            QVector<double> merged(2 * n + 1);
+            double err = 0.0;
+            for (int j = 0; j <= 2 * n; ++j) {
+                if (j % 2 == 0) { merged[j] = s.values[j / 2]; continue; }
+                double v = std::log(p[i]);
+                err = std::max(err, std::abs(v - interpolate(s, u[i])));
+                merged[j] = v;
+                ++i;
+            }
+            s.values = merged;
+            s.error = err;
+            if (err <= m_relTol) {
+                s.done = true;
+                next.append(s);
+            } else if (2 * n < MAX_DEGREE) {
+                next.append(s);
+            } else {
+                // 节点数已达上限: 二分后重新开始
+                double mid = 0.5 * (s.a + s.b);
+                Segment left = s, right = s;
+                left.b = mid; right.a = mid;
+                left.values.clear(); right.values.clear();
+                left.error = right.error = std::numeric_limits<double>::infinity();
+                next.append(left);
+                next.append(right);
+            }
+        }
+        m_segments = next;
+    }
+
+    for (const Segment& s : m_segments) m_estimatedError = std::max(m_estimatedError, s.error);
+    m_valid = true;
+    return true;
+}
+
+double LaplaceSpaceCache::value(double z) const
+{
+    if (!m_valid || !(z > 0.0)) return 0.0;
+    double u = std::max(m_uMin, std::min(std::log(z), m_uMax));
+
+    // 二分查找所在段
+    int lo = 0, hi = m_segments.size() - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (m_segments[mid].a <= u) lo = mid;
+        else hi = mid - 1;
+    }
+    return std::exp(interpolate(m_segments[lo], u));
+}
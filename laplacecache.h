@@ -0,0 +1,73 @@
+/*
+ * laplacecache.h
+ * 文件作用：拉普拉斯空间插值缓存头文件
+ * 功能描述：
+ * 1. 对当前参数在自适应的对数 z 网格上计算一次像函数 p̄(z)，
+ *    之后所有反演节点的像函数值均由插值得到，不再逐点求解线性方程组
+ * 2. 插值在 (ln z, ln p̄) 上进行：ln z 轴分段，每段在 Chebyshev-Lobatto 节点上做重心插值，
+ *    ln p̄ 关于 ln z 解析光滑，插值误差随节点数指数下降
+ * 3. 误差控制: 每段节点数逐次加倍 (旧节点全部复用)，以新增节点处的插值误差作为误差估计，
+ *    超出容差且节点数已达上限时二分该段
+ * 4. 像函数出现非正值或非有限值时缓存标记为无效，调用方应回退到逐点计算
+ */
+
+#ifndef LAPLACECACHE_H
+#define LAPLACECACHE_H
+
+#include <QVector>
+#include <functional>
+
+class LaplaceSpaceCache
+{
+public:
+    // 批量像函数: 计算 z[0..n-1] 处的 p̄ (调用方可在内部并行)
+    using BatchKernel = std::function<void(const double* z, double* values, int n)>;
+
+    LaplaceSpaceCache();
+
+    // 误差控制参数 (ln p̄ 的绝对误差即 p̄ 的相对误差)
+    // Stehfest 权重正负交替且绝对值很大，节点间不相关的误差会被放大，因此默认容差取得较严
+    void setTolerance(double relTol) { m_relTol = relTol; }
+    void setMaxKernelCalls(int n) { m_maxKernelCalls = n; }
+
+    // 在 [zMin, zMax] 上建立插值；返回 false 表示缓存不可用
+    bool build(double zMin, double zMax, const BatchKernel& kernel);
+
+    bool isValid() const { return m_valid; }
+
+    // 插值得到 p̄(z)，z 超出 build 范围时取端点值
+    double value(double z) const;
+
+    // 建立插值所用的核函数调用次数
+    int kernelCalls() const { return m_kernelCalls; }
+
+    // 各段误差估计的最大值 (全部收敛时不超过容差)
+    double estimatedError() const { return m_estimatedError; }
+
+private:
+    // ln z 轴上的一段: values 为 Lobatto 节点 cos(jπ/n) (j = 0..n) 处的 ln p̄
+    struct Segment {
+        double a;
+        double b;
+        QVector<double> values;
+        double error;
+        bool done;
+    };
+
+    static double lobattoNode(const Segment& s, int j, int n);
+    static double interpolate(const Segment& s, double u);
+
+private:
+    double m_relTol;
+    int m_maxKernelCalls;
+
+    QVector<Segment> m_segments; // 按 a 递增
+    double m_uMin;
+    double m_uMax;
+
+    bool m_valid;
+    int m_kernelCalls;
+    double m_estimatedError;
+};
+
+#endif // LAPLACECACHE_H
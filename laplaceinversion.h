@@ -0,0 +1,57 @@
+/*
+ * laplaceinversion.h
+ * 文件作用：拉普拉斯数值反演后端接口头文件
+ * 功能描述：
+ * 1. 统一的反演接口: 先由 nodes() 给出时间 t 所需的拉普拉斯变量 z，
+ *    调用方在这些 z 上计算像函数后，再由 invert() 合成 f(t)
+ * 2. Stehfest 后端: N = 4, 6, ..., 18 的权重表在编译期生成，计算时直接查表
+ * 3. Gaver-Wynn-Rho 后端: Gaver 泛函 + Wynn rho 加速，同样只需实轴上的像函数值
+ * 4. 每个后端报告单个时间点的核函数调用次数，便于在精度与计算量之间取舍
+ * 5. 后端对象无内部状态，通过 get() 取得的共享实例可在多线程中同时使用
+ * 6. invertTangent() 给出反演结果对像函数值的方向导数，供前向自动微分使用
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <QString>
+
+class LaplaceInverter
+{
+public:
+    enum Method {
+        Stehfest = 0,     // Gaver-Stehfest
+        GaverWynnRho = 1  // Gaver 泛函 + Wynn rho 加速 (Valkó-Abate)
+    };
+
+    // 单个时间点允许的最大核函数调用次数 (调用方可据此分配栈上缓冲区)
+    static const int MAX_KERNEL_CALLS = 20;
+
+    virtual ~LaplaceInverter() {}
+
+    virtual Method method() const = 0;
+
+    // 反演阶数 (Stehfest 的 N，GWR 的核函数调用次数)
+    virtual int order() const = 0;
+
+    // 单个时间点需要计算的像函数次数
+    virtual int kernelCalls() const = 0;
+
+    // 写出时间 t 对应的 kernelCalls() 个拉普拉斯变量
+    virtual void nodes(double t, double* z) const = 0;
+
+    // 由 nodes() 各节点处的像函数值合成 f(t)
+    virtual double invert(double t, const double* values) const = 0;
+
+    // invert() 在 t 固定时沿 tangents 方向的方向导数: Σ ∂f/∂values[m] · tangents[m]
+    // 两种后端的 f 均为 (ln2/t) 乘以像函数值的一次齐次函数，因此 ∂f/∂t = -f/t
+    virtual double invertTangent(double t, const double* values, const double* tangents) const = 0;
+
+    // 显示用名称，如 "Stehfest N=8"
+    QString name() const;
+
+    // 取得共享的反演后端实例；order 不合法时取最接近的合法阶数
+    static const LaplaceInverter* get(Method method, int order);
+};
+
+#endif // LAPLACEINVERSION_H
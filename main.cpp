@@ -7,14 +7,17 @@
  * 3. 应用全局样式表 (StyleSheet) 以美化界面控件
  * 4. 设置全局调色板以适配不同系统主题的文本颜色
  * 5. 启动主窗口
+ * 6. 命令行参数 --generate-typecurves <目录>: 只生成各模型的样板曲线库后退出，不启动界面
  */
 
 #include "mainwindow.h"
+#include "typecurvedatabase.h"
 #include <QApplication>
 #include <QStyleFactory>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QIcon>
+#include <QDebug>
 
 int main(int argc, char *argv[])
 {
@@ -26,6 +29,19 @@ int main(int argc, char *argv[])
 
     QApplication app(argc, argv);
 
+    // 离线生成样板曲线库
+    const QStringList args = app.arguments();
+    int generateIndex = args.indexOf("--generate-typecurves");
+    if (generateIndex >= 0) {
+        QString dir = (generateIndex + 1 < args.size()) ? args[generateIndex + 1] : QString("typecurves");
+        QString error;
+        if (!TypeCurveDatabase::generateDefaultDatabases(dir, &error)) {
+            qCritical().noquote() << error;
+            return 1;
+        }
+        return 0;
+    }
+
     // 设置软件全局图标
     app.setWindowIcon(QIcon(":/new/prefix1/Resource/PWT.png"));
 
@@ -5,18 +5,23 @@
  * 1. 管理所有试井模型的生命周期和界面切换
  * 2. 创建并配置模型选择的UI区域
  * 3. 协调模型计算请求与结果信号
+ * 4. 理论曲线计算直接交给无界面内核 ModelSolver01_06，不再经过界面实例
+ * 5. 启动时加载程序目录下 typecurves/ 中的样板曲线库，交互预览优先查表
  */
 
 #include "modelmanager.h"
 #include "modelselect.h"
 #include "modelparameter.h"
 #include "modelwidget01-06.h" // 包含合并后的类
+#include "modelsolver01-06.h" // 无界面计算内核
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QGroupBox>
 #include <QDebug>
+#include <QCoreApplication>
+#include <QFileInfo>
 #include <cmath>
 
 ModelManager::ModelManager(QWidget* parent)
@@ -25,7 +30,11 @@ ModelManager::ModelManager(QWidget* parent)
 {
 }
 
-ModelManager::~ModelManager() {}
+ModelManager::~ModelManager()
+{
+    m_typeCurveMatcher.setDatabases(QList<const TypeCurveDatabase*>());
+    qDeleteAll(m_typeCurveDatabases);
+}
 
 void ModelManager::initializeModels(QWidget* parentWidget)
 {
@@ -54,6 +63,8 @@ void ModelManager::initializeModels(QWidget* parentWidget)
 
     switchToModel(Model_1);
 
+    loadTypeCurveDatabases(QCoreApplication::applicationDirPath() + "/typecurves");
+
     if (parentWidget->layout()) parentWidget->layout()->addWidget(m_mainWidget);
     else {
         QVBoxLayout* layout = new QVBoxLayout(parentWidget);
@@ -164,12 +175,6 @@ void ModelManager::onWidgetCalculationCompleted(const QString &t, const QMap<QSt
     emit calculationCompleted(t, r);
 }
 
-void ModelManager::setHighPrecision(bool high) {
-    for(ModelWidget01_06* w : m_modelWidgets) {
-        w->setHighPrecision(high);
-    }
-}
-
 void ModelManager::updateAllModelsBasicParameters()
 {
     for(ModelWidget01_06* w : m_modelWidgets) {
@@ -221,23 +226,97 @@ QMap<QString, double> ModelManager::getDefaultParameters(ModelType type)
     return p;
 }
 
-ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime)
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime, bool highPrecision) const
 {
     int index = (int)type;
-    if (index >= 0 && index < m_modelWidgets.size()) {
-        return m_modelWidgets[index]->calculateTheoreticalCurve(params, providedTime);
+    if (index < Model_1 || index > Model_6) return ModelCurveData();
+
+    // 计算内核不持有可变状态，每次调用独立构造，避免多个线程之间相互干扰
+    ModelSolver01_06 solver(type);
+    return solver.calculateTheoreticalCurve(params, providedTime, highPrecision);
+}
+
+ModelCurveData ModelManager::calculateCurveSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                                         const QVector<double>& providedTime, bool highPrecision,
+                                                         QVector<QVector<double>>& dP, QVector<QVector<double>>& dDP,
+                                                         const std::atomic<bool>* cancel) const
+{
+    int index = (int)type;
+    if (index < Model_1 || index > Model_6) return ModelCurveData();
+
+    ModelSolver01_06 solver(type);
+    return solver.calculateCurveSensitivities(params, names, providedTime, highPrecision, dP, dDP, cancel);
+}
+
+BatchCurveData ModelManager::calculateTheoreticalCurves(ModelType type, const ParameterBatch& batch, const QVector<double>& providedTime,
+                                                      bool highPrecision, const std::atomic<bool>* cancel) const
+{
+    int index = (int)type;
+    if (index < Model_1 || index > Model_6) return BatchCurveData();
+
+    ModelSolver01_06 solver(type);
+    return solver.calculateTheoreticalCurves(batch, providedTime, highPrecision, cancel);
+}
+
+ModelCurveData ModelManager::calculatePreviewCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime) const
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+
+    for (const TypeCurveDatabase* db : m_typeCurveDatabases) {
+        if (db->modelType() != type) continue;
+
+        QVector<double> tD = ModelSolver01_06::dimensionlessTime(params, tPoints);
+        QVector<double> pD, dpD;
+        if (!db->lookup(params, tD, pD, dpD)) break;
+
+        double factor = ModelSolver01_06::pressureFactor(params);
+        QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
+        for (int i = 0; i < tPoints.size(); ++i) {
+            finalP[i] = factor * pD[i];
+            finalDP[i] = factor * dpD[i];
+        }
+        return std::make_tuple(tPoints, finalP, finalDP);
     }
-    return ModelCurveData();
+
+    return calculateTheoreticalCurve(type, params, tPoints, true);
 }
 
-QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
-    QVector<double> t;
-    t.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        double exponent = startExp + (endExp - startExp) * i / (count - 1);
-        t.append(pow(10.0, exponent));
+void ModelManager::loadTypeCurveDatabases(const QString& dir)
+{
+    m_typeCurveMatcher.setDatabases(QList<const TypeCurveDatabase*>());
+    qDeleteAll(m_typeCurveDatabases);
+    m_typeCurveDatabases.clear();
+
+    for (int i = Model_1; i <= Model_6; ++i) {
+        QString path = dir + "/" + TypeCurveDatabase::fileName((ModelType)i);
+        if (!QFileInfo::exists(path)) continue;
+
+        TypeCurveDatabase* db = new TypeCurveDatabase();
+        QString error;
+        if (db->open(path, &error) && db->modelType() == (ModelType)i) {
+            m_typeCurveDatabases.append(db);
+        } else {
+            qWarning() << "样板曲线库不可用:" << (error.isEmpty() ? path : error);
+            delete db;
+        }
     }
-    return t;
+
+    QList<const TypeCurveDatabase*> databases;
+    for (const TypeCurveDatabase* db : m_typeCurveDatabases) databases.append(db);
+    m_typeCurveMatcher.setDatabases(databases);
+}
+
+QVector<TypeCurveMatch> ModelManager::matchTypeCurves(const QVector<double>& t, const QVector<double>& d,
+                                                      const QMap<QString, double>& basicParams, int count) const
+{
+    return m_typeCurveMatcher.match(t, d, basicParams, count);
+}
+
+QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
+    return ModelSolver01_06::generateLogTimeSteps(count, startExp, endExp);
 }
 
 void ModelManager::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d)
@@ -6,9 +6,12 @@
 #include <QVector>
 #include <QStackedWidget>
 #include <QPushButton>
+#include <QList>
 
 // 引入合并后的 ModelWidget 头文件
 #include "modelwidget01-06.h"
+#include "typecurvedatabase.h"
+#include "typecurvematcher.h"
 
 class ModelManager : public QObject
 {
@@ -37,14 +40,38 @@ public:
     static QString getModelTypeName(ModelType type);
 
     // 计算理论曲线接口 (供 FittingWidget 使用)
-    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    // 直接调用无界面计算内核，可在任意线程中并发调用；精度按调用单独指定
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>(), bool highPrecision = true) const;
+
+    // 计算理论曲线及其对 names 中各参数的偏导数 (前向自动微分，供拟合计算雅可比矩阵)
+    // dP[k][i]、dDP[k][i] 为第 i 个时间点的压力、压力导数对 names[k] 的偏导数
+    // cancel 被置位后剩余计算取消 (用于拟合中的停止按钮)，此时结果不完整
+    ModelCurveData calculateCurveSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                               const QVector<double>& providedTime, bool highPrecision,
+                                               QVector<QVector<double>>& dP, QVector<QVector<double>>& dDP,
+                                               const std::atomic<bool>* cancel = nullptr) const;
+
+    // 批量计算多组参数的理论曲线 (参数按列给出，共用时间序列，结果连续存放)，可在任意线程中并发调用
+    // 比逐组调用 calculateTheoreticalCurve 少去重复的参数解析与线程同步，无量纲问题相同的组共用像函数计算
+    BatchCurveData calculateTheoreticalCurves(ModelType type, const ParameterBatch& batch,
+                                              const QVector<double>& providedTime = QVector<double>(),
+                                              bool highPrecision = true, const std::atomic<bool>* cancel = nullptr) const;
+
+    // 计算用于交互预览的理论曲线: 优先在已加载的样板曲线库中插值，
+    // 没有对应曲线库或参数超出其覆盖范围时回退到 calculateTheoreticalCurve (高精度)
+    ModelCurveData calculatePreviewCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>()) const;
+
+    // 加载 dir 下各模型的样板曲线库 (文件名见 TypeCurveDatabase::fileName)，不存在的文件跳过
+    void loadTypeCurveDatabases(const QString& dir);
+
+    // 按实测导数的形状在已加载的样板曲线库中快速匹配模型与参数 (可在任意线程中调用)，
+    // 返回按形状偏差递增的 count 个结果；没有曲线库或数据不足时为空
+    QVector<TypeCurveMatch> matchTypeCurves(const QVector<double>& t, const QVector<double>& d,
+                                            const QMap<QString, double>& basicParams, int count) const;
 
     // 获取默认参数 (供 FittingWidget 使用)
     QMap<QString, double> getDefaultParameters(ModelType type);
 
-    // 设置所有模型的高精度模式
-    void setHighPrecision(bool high);
-
     // 刷新所有模型的基础参数
     void updateAllModelsBasicParameters();
 
@@ -85,6 +112,11 @@ private:
     QVector<double> m_cachedObsTime;
     QVector<double> m_cachedObsPressure;
     QVector<double> m_cachedObsDerivative;
+
+    // 已加载的样板曲线库 (内存映射，只读，可在多个线程中同时查询)
+    QList<TypeCurveDatabase*> m_typeCurveDatabases;
+    // 基于上述曲线库的导数形状匹配
+    TypeCurveMatcher m_typeCurveMatcher;
 };
 
 #endif // MODELMANAGER_H
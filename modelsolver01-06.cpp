@@ -0,0 +1,989 @@
+/*
+ * modelsolver01-06.cpp
+ * 文件作用：压裂水平井复合页岩油模型 (模型1-6) 计算内核实现文件
+ * 功能描述：
+ * 1. Model 1/2: 无限大边界 (MATLAB: mAB=0)
+ * 2. Model 3/4: 封闭边界 (MATLAB: mAB=K1/I1)
+ * 3. Model 5/6: 定压边界 (MATLAB: mAB=-K0/I0)
+ * 4. 奇数模型考虑变井储与表皮 (CD/S non-zero)，偶数模型为恒定井储 (CD/S=0)
+ * 5. 内核函数均为静态函数，所有输入通过参数和只读上下文传入，线程安全
+ *    模型参数在每条曲线开始前解析为 KernelParams，核函数内不再查 QMap
+ * 6. 各时间点的拉普拉斯反演在专用线程池中并行执行，反演后端见 LaplaceInverter
+ *    时间点很多时改为在自适应 z 网格上计算一次像函数，反演节点由插值得到 (LaplaceSpaceCache)
+ * 7. 裂缝等间距共线时影响矩阵为对称 Toeplitz 矩阵，只计算 nf 个不同的积分
+ * 8. 共线裂缝的 K0/I0 线源积分使用 BesselIntegral 闭式积分核，不再逐点数值积分
+ * 9. Bessel 函数统一由 BesselBatch 批量计算 (rmD/reD 边界项一次计算，积分节点整组计算)
+ * 10. 裂缝方程组按加边结构求解: 先解 A y = 1，再由流量约束得 pwD = 1/(z Σy)；
+ *     nf <= 8 时使用栈上的定长 Eigen 矩阵 (按 nf 查表分派)，核函数内不做堆分配
+ * 11. 核函数链 (flaplace_composite -> PWD_composite -> 反演 -> 压力换算) 对标量类型泛型，
+ *     以 DualNumber 计算一遍即得到曲线及其对拟合参数的偏导数 (calculateCurveSensitivities)：
+ *     Bessel 函数与线源积分按解析导数传播，线性方程组复用 LU 分解求 ẏ = -A⁻¹ Ȧ y
+ * 12. 批量计算 (calculateTheoreticalCurves): 参数按列给出，全部 (组, 时间点) 在一次并行循环中反演；
+ *     无量纲问题相同的组共用一个拉普拉斯空间插值缓存
+ * 13. 自适应采样 (calculateAdaptiveCurve): 粗对数网格逐轮在双对数插值误差超差的区间插入中点，
+ *     每轮新增的时间点一次并行反演，最终网格上统一计算 Bourdet 导数
+ */
+
+#include "modelsolver01-06.h"
+#include "pressurederivativecalculator.h"
+#include "parallelfor.h"
+#include "besselintegral.h"
+#include "besselbatch.h"
+#include "laplaceinversion.h"
+#include "laplacecache.h"
+#include "dualnumber.h"
+
+#include <QPair>
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// 使用定长矩阵求解的最大裂缝条数，更多裂缝时退回动态矩阵
+const int MAX_FIXED_FRACTURES = 8;
+
+// 加边方程组 [A -1; z·1ᵀ 0][q; p] = [0; 1] 的解: A q = p·1 且 z Σq = 1，
+// 令 y = A⁻¹·1，则 q = p·y，p = 1/(z Σy)。A 按列存储，主维为 nf
+template <int NF>
+double solveBorderedSystem(const double* A, int nf, double z)
+{
+    typedef Eigen::Matrix<double, NF, NF> Matrix;
+    typedef Eigen::Matrix<double, NF, 1> Vector;
+    Matrix M = Eigen::Map<const Matrix>(A, nf, nf);
+    Vector y = M.fullPivLu().solve(Vector::Ones(nf));
+    return 1.0 / (z * y.sum());
+}
+
+typedef double (*BorderedSolver)(const double* A, int nf, double z);
+
+const BorderedSolver BORDERED_SOLVERS[MAX_FIXED_FRACTURES + 1] = {
+    nullptr,
+    &solveBorderedSystem<1>, &solveBorderedSystem<2>, &solveBorderedSystem<3>, &solveBorderedSystem<4>,
+    &solveBorderedSystem<5>, &solveBorderedSystem<6>, &solveBorderedSystem<7>, &solveBorderedSystem<8>
+};
+
+// 对偶数版本: 函数值部分与 double 版本相同；A 的每个方向导数 Ȧ_k 对应 ẏ_k = -A⁻¹ Ȧ_k y (复用同一 LU 分解)
+template <int NF>
+DualNumber solveBorderedSystem(const DualNumber* A, int nf, const DualNumber& z)
+{
+    typedef Eigen::Matrix<double, NF, NF> Matrix;
+    typedef Eigen::Matrix<double, NF, 1> Vector;
+    Matrix M;
+    M.resize(nf, nf);
+    int count = 0;
+    for (int j = 0; j < nf; ++j) {
+        for (int i = 0; i < nf; ++i) {
+            M(i, j) = A[i + j * nf].value();
+            count = std::max(count, A[i + j * nf].count());
+        }
+    }
+    Eigen::FullPivLU<Matrix> lu = M.fullPivLu();
+    Vector y = lu.solve(Vector::Ones(nf));
+
+    DualNumber sum(y.sum());
+    sum.setCount(count);
+    Vector rhs;
+    rhs.resize(nf);
+    for (int k = 0; k < count; ++k) {
+        for (int i = 0; i < nf; ++i) {
+            double s = 0.0;
+            for (int j = 0; j < nf; ++j) s -= A[i + j * nf].tangent(k) * y(j);
+            rhs(i) = s;
+        }
+        sum.setTangent(k, lu.solve(rhs).sum());
+    }
+    return 1.0 / (z * sum);
+}
+
+typedef DualNumber (*DualBorderedSolver)(const DualNumber* A, int nf, const DualNumber& z);
+
+const DualBorderedSolver DUAL_BORDERED_SOLVERS[MAX_FIXED_FRACTURES + 1] = {
+    nullptr,
+    &solveBorderedSystem<1>, &solveBorderedSystem<2>, &solveBorderedSystem<3>, &solveBorderedSystem<4>,
+    &solveBorderedSystem<5>, &solveBorderedSystem<6>, &solveBorderedSystem<7>, &solveBorderedSystem<8>
+};
+
+double solveFractureSystem(const double* A, int nf, double z)
+{
+    if (nf <= MAX_FIXED_FRACTURES) return BORDERED_SOLVERS[nf](A, nf, z);
+    return solveBorderedSystem<Eigen::Dynamic>(A, nf, z);
+}
+
+DualNumber solveFractureSystem(const DualNumber* A, int nf, const DualNumber& z)
+{
+    if (nf <= MAX_FIXED_FRACTURES) return DUAL_BORDERED_SOLVERS[nf](A, nf, z);
+    return solveBorderedSystem<Eigen::Dynamic>(A, nf, z);
+}
+
+// ---------------- 核函数中与标量类型相关的运算 (double 直接计算，DualNumber 按解析导数传播) ----------------
+
+bool hasTangents(double) { return false; }
+bool hasTangents(const DualNumber& x) { return x.count() > 0; }
+
+void besselScaled(const double* x, int n, double* i0s, double* i1s, double* k0s, double* k1s)
+{
+    BesselBatch::evaluateScaled(x, n, i0s, i1s, k0s, k1s);
+}
+
+// 缩放函数的导数: (e^-x I0)' = i1s - i0s，(e^-x I1)' = i0s - i1s/x - i1s，
+//                 (e^x K0)' = k0s - k1s，  (e^x K1)' = k1s - k0s - k1s/x
+void besselScaled(const DualNumber* x, int n, DualNumber* i0s, DualNumber* i1s, DualNumber* k0s, DualNumber* k1s)
+{
+    const int CHUNK = 16;
+    for (int base = 0; base < n; base += CHUNK) {
+        int m = std::min(CHUNK, n - base);
+        double xv[CHUNK], a[CHUNK], b[CHUNK], c[CHUNK], d[CHUNK];
+        for (int q = 0; q < m; ++q) xv[q] = x[base + q].value();
+        BesselBatch::evaluateScaled(xv, m, a, b, c, d);
+        for (int q = 0; q < m; ++q) {
+            const DualNumber& xq = x[base + q];
+            double inv = 1.0 / xv[q];
+            if (i0s) i0s[base + q] = DualNumber::chain(a[q], b[q] - a[q], xq);
+            if (i1s) i1s[base + q] = DualNumber::chain(b[q], a[q] - b[q] * inv - b[q], xq);
+            if (k0s) k0s[base + q] = DualNumber::chain(c[q], c[q] - d[q], xq);
+            if (k1s) k1s[base + q] = DualNumber::chain(d[q], d[q] - c[q] - d[q] * inv, xq);
+        }
+    }
+}
+
+// 线源积分被积函数在端点 u 处的值: K0(|u|) 与 exp(-shift) I0(|u|)
+void segmentIntegrands(double u, double shift, double& k0, double& i0Shifted)
+{
+    double x = std::max(std::abs(u), 1e-10);
+    double i0s, i1s, k0s, k1s;
+    BesselBatch::evaluateScaled(x, i0s, i1s, k0s, k1s);
+    k0 = k0s * std::exp(-x);
+    i0Shifted = i0s * std::exp(x - shift);
+}
+
+double lineSegmentK0(double lo, double hi) { return BesselIntegral::segmentK0(lo, hi); }
+double lineSegmentI0(double lo, double hi, double shift) { return BesselIntegral::segmentI0(lo, hi, shift); }
+
+// d/dhi ∫lo^hi K0(|u|)du = K0(|hi|)，d/dlo = -K0(|lo|)
+DualNumber lineSegmentK0(const DualNumber& lo, const DualNumber& hi)
+{
+    double v = BesselIntegral::segmentK0(lo.value(), hi.value());
+    if (hi.value() <= lo.value()) return DualNumber(v);
+    double kLo, kHi, iLo, iHi;
+    segmentIntegrands(lo.value(), 0.0, kLo, iLo);
+    segmentIntegrands(hi.value(), 0.0, kHi, iHi);
+    return DualNumber::combine(v, -kLo, lo, kHi, hi);
+}
+
+// exp(-shift) ∫lo^hi I0(|u|)du: 对 hi、lo 的导数为端点处被积函数值，对 shift 的导数为 -值
+DualNumber lineSegmentI0(const DualNumber& lo, const DualNumber& hi, const DualNumber& shift)
+{
+    double v = BesselIntegral::segmentI0(lo.value(), hi.value(), shift.value());
+    if (hi.value() <= lo.value()) return DualNumber(v);
+    double kLo, kHi, iLo, iHi;
+    segmentIntegrands(lo.value(), shift.value(), kLo, iLo);
+    segmentIntegrands(hi.value(), shift.value(), kHi, iHi);
+    DualNumber r = DualNumber::combine(v, -iLo, lo, iHi, hi);
+    return DualNumber::combine(v, 1.0, r, -v, shift);
+}
+
+} // namespace
+
+ModelSolver01_06::ModelSolver01_06(ModelType type)
+    : m_type(type)
+{
+}
+
+bool ModelSolver01_06::hasWellboreStorage(ModelType type)
+{
+    return (type == Model_1 || type == Model_3 || type == Model_5);
+}
+
+bool ModelSolver01_06::isInfiniteBoundary(ModelType type)
+{
+    return (type == Model_1 || type == Model_2);
+}
+
+void ParameterBatch::setColumn(const QString& name, const QVector<double>& values)
+{
+    if (columns.isEmpty()) size = values.size();
+    columns[name] = values;
+}
+
+QMap<QString, double> ParameterBatch::at(int i) const
+{
+    QMap<QString, double> params = base;
+    for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+        params[it.key()] = it.value()[i];
+    }
+    if ((columns.contains("L") || columns.contains("Lf")) && params.contains("Lf") && params.value("L") > 1e-9) {
+        params["LfD"] = params["Lf"] / params["L"];
+    }
+    return params;
+}
+
+ModelCurveData BatchCurveData::curve(int i) const
+{
+    int n = t.size();
+    QVector<double> p(n), d(n);
+    std::copy(pressureOf(i), pressureOf(i) + n, p.begin());
+    std::copy(derivativeOf(i), derivativeOf(i) + n, d.begin());
+    return std::make_tuple(t, p, d);
+}
+
+QVector<double> ModelSolver01_06::generateLogTimeSteps(int count, double startExp, double endExp)
+{
+    QVector<double> t;
+    t.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        double exponent = startExp + (endExp - startExp) * i / (count - 1);
+        t.append(pow(10.0, exponent));
+    }
+    return t;
+}
+
+ModelSolver01_06::EvalContext ModelSolver01_06::makeContext(const QMap<QString, double>& params, bool highPrecision) const
+{
+    EvalContext ctx;
+    int N_param = (int)params.value("N", 4);
+    int N = highPrecision ? N_param : 4;
+    if (N % 2 != 0) N = 4;
+    int method = (int)params.value("LaplaceMethod", LaplaceInverter::Stehfest);
+    ctx.inverter = LaplaceInverter::get(method == LaplaceInverter::GaverWynnRho ? LaplaceInverter::GaverWynnRho
+                                                                                : LaplaceInverter::Stehfest, N);
+    // 获取压敏系数 (MATLAB: gamaD)
+    ctx.gamaD = params.value("gamaD", 0.0);
+    ctx.laplaceCache = (int)params.value("LaplaceCache", -1);
+    ctx.kernel = makeKernelParams(m_type, params);
+    return ctx;
+}
+
+template <class Scalar, class Getter>
+ModelSolver01_06::KernelParamsT<Scalar> ModelSolver01_06::buildKernelParams(ModelType type, const Getter& get)
+{
+    KernelParamsT<Scalar> kp;
+    kp.type = type;
+    Scalar kf = get("kf", 0.0);
+    Scalar km = get("km", 0.0);
+    kp.M12 = kf / km;
+    kp.LfD = get("LfD", 0.0);
+    kp.rmD = get("rmD", 0.0);
+    kp.reD = get("reD", 0.0); // 默认0表示无限大(如果未设置)
+    kp.omega1 = get("omega1", 0.0);
+    kp.omega2 = get("omega2", 0.0);
+    kp.lambda1 = get("lambda1", 0.0);
+
+    // 井筒储存和表皮仅对变井储模型 (1, 3, 5) 启用
+    kp.cD = get("cD", 0.0);
+    kp.S = get("S", 0.0);
+    kp.applyStorage = hasWellboreStorage(type)
+                      && (primalValue(kp.cD) > 1e-12 || std::abs(primalValue(kp.S)) > 1e-12);
+
+    int nf = (int)primalValue(get("nf", 4.0)); if(nf < 1) nf = 1;
+    kp.nf = nf;
+    if (nf == 1) { kp.xwD.append(0.0); } else {
+        double start = -0.9; double end = 0.9; double step = (end - start) / (nf - 1);
+        for(int i=0; i<nf; ++i) kp.xwD.append(start + i * step);
+    }
+    kp.ywD = QVector<double>(nf, 0.0);
+    kp.uniformLayout = isUniformFractureLayout(kp.xwD, kp.ywD);
+    return kp;
+}
+
+ModelSolver01_06::KernelParams ModelSolver01_06::makeKernelParams(ModelType type, const QMap<QString, double>& params)
+{
+    return buildKernelParams<double>(type, [&params](const QString& name, double defaultValue) {
+        return params.value(name, defaultValue);
+    });
+}
+
+QVector<double> ModelSolver01_06::dimensionlessTime(const QMap<QString, double>& params, const QVector<double>& t)
+{
+    double phi = params.value("phi", 0.05);
+    double mu = params.value("mu", 0.5);
+    double Ct = params.value("Ct", 5e-4);
+    double kf = params.value("kf", 1e-3);
+    double L = params.value("L", 1000.0);
+
+    QVector<double> tD;
+    tD.reserve(t.size());
+    for(double ti : t) {
+        double val = 14.4 * kf * ti / (phi * mu * Ct * pow(L, 2));
+        tD.append(val);
+    }
+    return tD;
+}
+
+double ModelSolver01_06::pressureFactor(const QMap<QString, double>& params)
+{
+    double mu = params.value("mu", 0.5);
+    double B = params.value("B", 1.05);
+    double q = params.value("q", 5.0);
+    double h = params.value("h", 20.0);
+    double kf = params.value("kf", 1e-3);
+    return 1.842e-3 * q * mu * B / (kf * h);
+}
+
+int ModelSolver01_06::calculateDimensionlessCurve(const QMap<QString, double>& params, const QVector<double>& tD, bool highPrecision,
+                                                  QVector<double>& pD, QVector<double>& dpD) const
+{
+    EvalContext ctx = makeContext(params, highPrecision);
+    return calculatePDandDeriv(tD, ctx, pD, dpD);
+}
+
+ModelCurveData ModelSolver01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime, bool highPrecision, int* kernelCalls) const
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+
+    QVector<double> tD_vec = dimensionlessTime(params, tPoints);
+
+    QVector<double> PD_vec, Deriv_vec;
+    int calls = calculateDimensionlessCurve(params, tD_vec, highPrecision, PD_vec, Deriv_vec);
+    if (kernelCalls) *kernelCalls = calls;
+
+    double factor = pressureFactor(params);
+    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
+
+    for(int i=0; i<tPoints.size(); ++i) {
+        finalP[i] = factor * PD_vec[i];
+        finalDP[i] = factor * Deriv_vec[i];
+    }
+
+    return std::make_tuple(tPoints, finalP, finalDP);
+}
+
+ModelCurveData ModelSolver01_06::calculateAdaptiveCurve(const QMap<QString, double>& params, double tMin, double tMax,
+                                                        int maxPoints, double tolerance, bool highPrecision,
+                                                        int* kernelCalls, const std::atomic<bool>* cancel) const
+{
+    EvalContext ctx = makeContext(params, highPrecision);
+    double xMin = std::log10(tMin);
+    double xMax = std::log10(tMax);
+
+    // 1. 粗网格
+    int coarse = (int)std::ceil((xMax - xMin) * ADAPTIVE_COARSE_PER_CYCLE) + 1;
+    coarse = std::max(3, std::min(coarse, maxPoints));
+    QVector<double> t = generateLogTimeSteps(coarse, xMin, xMax);
+    QVector<double> pD, dpD;
+    int calls = calculatePDandDeriv(dimensionlessTime(params, t), ctx, pD, dpD);
+
+    // 2. 逐轮细分: 每轮把超差区间按误差从大到小取中点 (受剩余点数限制)，新点一次并行计算
+    while (t.size() < maxPoints && !(cancel && *cancel)) {
+        int n = t.size();
+        dpD = PressureDerivativeCalculator::calculateBourdetDerivative(dimensionlessTime(params, t), pD, 0.1);
+
+        // 双对数坐标；导数趋于 0 (如定压边界) 时按压力最大值的 1e-3 截断，不追逐无意义的细节
+        double pFloor = 1e-3 * std::max(1e-30, *std::max_element(pD.constBegin(), pD.constEnd()));
+        QVector<double> x(n), yp(n), yd(n);
+        for (int i = 0; i < n; ++i) {
+            x[i] = std::log10(t[i]);
+            yp[i] = std::log10(std::max(pD[i], pFloor));
+            yd[i] = std::log10(std::max(dpD[i], pFloor));
+        }
+
+        // 各节点二阶导数 (非等距三点差分)，端点取相邻节点的值
+        QVector<double> curvature(n, 0.0);
+        for (int i = 1; i + 1 < n; ++i) {
+            double h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+            double cp = 2.0 * ((yp[i + 1] - yp[i]) / h1 - (yp[i] - yp[i - 1]) / h0) / (h0 + h1);
+            double cd = 2.0 * ((yd[i + 1] - yd[i]) / h1 - (yd[i] - yd[i - 1]) / h0) / (h0 + h1);
+            curvature[i] = std::max(std::abs(cp), std::abs(cd));
+        }
+        curvature[0] = curvature[1];
+        curvature[n - 1] = curvature[n - 2];
+
+        QVector<QPair<double, int>> candidates;
+        for (int k = 0; k + 1 < n; ++k) {
+            double h = x[k + 1] - x[k];
+            if (h < 2.0 * ADAPTIVE_MIN_SPACING) continue;
+            double err = std::max(curvature[k], curvature[k + 1]) * h * h / 8.0;
+            if (err > tolerance) candidates.append(qMakePair(err, k));
+        }
+        if (candidates.isEmpty()) break;
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const QPair<double, int>& a, const QPair<double, int>& b) { return a.first > b.first; });
+        candidates.resize(std::min(candidates.size(), maxPoints - n));
+
+        QVector<double> tNew(candidates.size());
+        for (int c = 0; c < candidates.size(); ++c) {
+            int k = candidates[c].second;
+            tNew[c] = std::pow(10.0, 0.5 * (x[k] + x[k + 1]));
+        }
+        std::sort(tNew.begin(), tNew.end());
+        QVector<double> pNew, dNew;
+        calls += calculatePDandDeriv(dimensionlessTime(params, tNew), ctx, pNew, dNew);
+
+        // 合并为递增序列
+        QVector<double> tMerged(n + tNew.size()), pMerged(n + tNew.size());
+        int i = 0, j = 0;
+        for (int m = 0; m < tMerged.size(); ++m) {
+            bool takeOld = (j >= tNew.size()) || (i < n && t[i] < tNew[j]);
+            tMerged[m] = takeOld ? t[i] : tNew[j];
+            pMerged[m] = takeOld ? pD[i++] : pNew[j++];
+        }
+        t = tMerged;
+        pD = pMerged;
+    }
+    if (kernelCalls) *kernelCalls = calls;
+
+    // 3. 最终网格上的 Bourdet 导数与有量纲换算
+    int n = t.size();
+    dpD = PressureDerivativeCalculator::calculateBourdetDerivative(dimensionlessTime(params, t), pD, 0.1);
+    double factor = pressureFactor(params);
+    QVector<double> finalP(n), finalDP(n);
+    for (int i = 0; i < n; ++i) {
+        finalP[i] = factor * pD[i];
+        finalDP[i] = factor * dpD[i];
+    }
+    return std::make_tuple(t, finalP, finalDP);
+}
+
+ModelCurveData ModelSolver01_06::calculateCurveSensitivities(const QMap<QString, double>& params,
+                                                             const QStringList& names,
+                                                             const QVector<double>& providedTime,
+                                                             bool highPrecision,
+                                                             QVector<QVector<double>>& dP,
+                                                             QVector<QVector<double>>& dDP,
+                                                             const std::atomic<bool>* cancel) const
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) {
+        tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+    int numPoints = tPoints.size();
+    // 各行分别构造 (互不共享数据)，各批并行写入不同的行
+    dP.resize(names.size());
+    dDP.resize(names.size());
+    QVector<double>* dPRows = dP.data();
+    QVector<double>* dDPRows = dDP.data();
+    for (int k = 0; k < names.size(); ++k) {
+        dPRows[k] = QVector<double>(numPoints, 0.0);
+        dDPRows[k] = QVector<double>(numPoints, 0.0);
+    }
+
+    const LaplaceInverter* inverter = makeContext(params, highPrecision).inverter;
+    QVector<double> finalP(numPoints), finalDP(numPoints);
+
+    // 偏导数个数超过 DualNumber::MAX_TANGENTS 时分批，各批相互独立、并行计算 (每批完整计算一遍曲线)
+    // 批内各时间点同样并行；曲线本身由第 0 批写出
+    int batches = std::max(1, (int)((names.size() + DualNumber::MAX_TANGENTS - 1) / DualNumber::MAX_TANGENTS));
+    ParallelFor::run(batches, [&](int b) {
+        int first = b * DualNumber::MAX_TANGENTS;
+        QStringList batch = names.mid(first, DualNumber::MAX_TANGENTS);
+        int count = batch.size();
+
+        auto seeded = [&](const QString& name, double defaultValue) {
+            double v = params.value(name, defaultValue);
+            int k = batch.indexOf(name);
+            return (k >= 0) ? DualNumber::variable(v, k, count) : DualNumber(v);
+        };
+        auto get = [&](const QString& name, double defaultValue) {
+            DualNumber v = seeded(name, defaultValue);
+            // LfD 与 Lf/L 联动 (与拟合中的参数联动一致)，取值仍以参数表为准
+            if (name == "LfD" && params.contains("L") && params.contains("Lf") && params.value("L") > 1e-9) {
+                DualNumber ratio = seeded("Lf", 0.0) / seeded("L", 0.0);
+                v += ratio - ratio.value();
+            }
+            return v;
+        };
+
+        DualNumber phi = get("phi", 0.05);
+        DualNumber mu = get("mu", 0.5);
+        DualNumber B = get("B", 1.05);
+        DualNumber Ct = get("Ct", 5e-4);
+        DualNumber q = get("q", 5.0);
+        DualNumber h = get("h", 20.0);
+        DualNumber kf = get("kf", 1e-3);
+        DualNumber L = get("L", 1000.0);
+
+        QVector<DualNumber> tD(numPoints);
+        for (int i = 0; i < numPoints; ++i) {
+            tD[i] = 14.4 * kf * tPoints[i] / (phi * mu * Ct * (L * L));
+        }
+
+        KernelParamsT<DualNumber> kp = buildKernelParams<DualNumber>(m_type, get);
+        QVector<DualNumber> pd;
+        invertCurveSensitivity(tD, inverter, get("gamaD", 0.0), kp, pd, cancel);
+        if (cancel && cancel->load(std::memory_order_relaxed)) return;
+
+        // Bourdet 导数对压力是线性的，且只依赖 ln tD 的差值 (与 tD 的整体缩放无关)，
+        // 因此导数的偏导数即对 PD 的偏导数求 Bourdet 导数
+        QVector<double> tDv(numPoints), pdv(numPoints), dpd(numPoints);
+        for (int i = 0; i < numPoints; ++i) { tDv[i] = tD[i].value(); pdv[i] = pd[i].value(); }
+        auto bourdet = [&](const QVector<double>& y) {
+            if (numPoints > 2) return PressureDerivativeCalculator::calculateBourdetDerivative(tDv, y, 0.1);
+            return QVector<double>(numPoints, 0.0);
+        };
+        QVector<double> deriv = bourdet(pdv);
+
+        DualNumber factor = 1.842e-3 * q * mu * B / (kf * h);
+        if (b == 0) {
+            for (int i = 0; i < numPoints; ++i) {
+                finalP[i] = factor.value() * pdv[i];
+                finalDP[i] = factor.value() * deriv[i];
+            }
+        }
+        for (int k = 0; k < count; ++k) {
+            for (int i = 0; i < numPoints; ++i) dpd[i] = pd[i].tangent(k);
+            QVector<double> dDeriv = bourdet(dpd);
+            double* rowP = dPRows[first + k].data();
+            double* rowDP = dDPRows[first + k].data();
+            for (int i = 0; i < numPoints; ++i) {
+                rowP[i] = factor.tangent(k) * pdv[i] + factor.value() * dpd[i];
+                rowDP[i] = factor.tangent(k) * deriv[i] + factor.value() * dDeriv[i];
+            }
+        }
+    }, cancel);
+
+    return std::make_tuple(tPoints, finalP, finalDP);
+}
+
+void ModelSolver01_06::invertCurveSensitivity(const QVector<DualNumber>& tD, const LaplaceInverter* inverter,
+                                              const DualNumber& gamaD, const KernelParamsT<DualNumber>& kp,
+                                              QVector<DualNumber>& outPD, const std::atomic<bool>* cancel)
+{
+    int numPoints = tD.size();
+    outPD.resize(numPoints);
+    int calls = inverter->kernelCalls();
+
+    DualNumber* pdData = outPD.data();
+    ParallelFor::run(numPoints, [&](int k) {
+        const DualNumber& t = tD[k];
+        if (t.value() <= 1e-12) { pdData[k] = 0.0; return; }
+        double z[LaplaceInverter::MAX_KERNEL_CALLS], pv[LaplaceInverter::MAX_KERNEL_CALLS];
+        double dv[LaplaceInverter::MAX_KERNEL_CALLS];
+        DualNumber pf[LaplaceInverter::MAX_KERNEL_CALLS];
+        inverter->nodes(t.value(), z);
+        int count = t.count();
+        for (int m = 0; m < calls; ++m) {
+            // 反演节点 z = c/t，随 t 变化: dz = -z dt / t
+            pf[m] = flaplace_composite(DualNumber::chain(z[m], -z[m] / t.value(), t), kp);
+            if (std::isnan(pf[m].value()) || std::isinf(pf[m].value())) pf[m] = 0.0;
+            pv[m] = pf[m].value();
+            count = std::max(count, pf[m].count());
+        }
+
+        // f = invert(t, F)，F 固定时 ∂f/∂t = -f/t
+        double f = inverter->invert(t.value(), pv);
+        DualNumber pd(f);
+        pd.setCount(count);
+        for (int j = 0; j < count; ++j) {
+            for (int m = 0; m < calls; ++m) dv[m] = pf[m].tangent(j);
+            pd.setTangent(j, inverter->invertTangent(t.value(), pv, dv) - f * t.tangent(j) / t.value());
+        }
+
+        // 摄动法考虑压敏效应 (对应 MATLAB: -1/gamaD * log(1-gamaD*PD))
+        if (std::abs(gamaD.value()) > 1e-9) {
+            DualNumber arg = 1.0 - gamaD * pd;
+            if (arg.value() > 1e-12) {
+                pd = -1.0 / gamaD * log(arg);
+            }
+        }
+        pdData[k] = pd;
+    }, cancel);
+}
+
+int ModelSolver01_06::calculatePDandDeriv(const QVector<double>& tD, const EvalContext& ctx,
+                                          QVector<double>& outPD, QVector<double>& outDeriv)
+{
+    const KernelParams& kp = ctx.kernel;
+    return invertCurve(tD, ctx, [&kp](double z) { return flaplace_composite(z, kp); }, outPD, outDeriv);
+}
+
+template <class Kernel>
+double ModelSolver01_06::invertPoint(double tD, const EvalContext& ctx, const Kernel& kernel, const LaplaceSpaceCache* cache)
+{
+    if (tD <= 1e-12) return 0.0;
+    const LaplaceInverter* inverter = ctx.inverter;
+    int calls = inverter->kernelCalls();
+    double z[LaplaceInverter::MAX_KERNEL_CALLS], pf[LaplaceInverter::MAX_KERNEL_CALLS];
+    inverter->nodes(tD, z);
+    for (int m = 0; m < calls; ++m) {
+        pf[m] = cache ? cache->value(z[m]) : kernel(z[m]);
+        if (std::isnan(pf[m]) || std::isinf(pf[m])) pf[m] = 0.0;
+    }
+    double pd = inverter->invert(tD, pf);
+
+    // 摄动法考虑压敏效应 (对应 MATLAB: -1/gamaD * log(1-gamaD*PD))
+    double gamaD = ctx.gamaD;
+    if (std::abs(gamaD) > 1e-9) {
+        double arg = 1.0 - gamaD * pd;
+        if (arg > 1e-12) {
+            pd = -1.0 / gamaD * std::log(arg);
+        }
+    }
+    return pd;
+}
+
+template <class Kernel>
+bool ModelSolver01_06::buildLaplaceCache(double tMin, double tMax, int activePoints, const EvalContext& ctx,
+                                         const Kernel& kernel, LaplaceSpaceCache& cache)
+{
+    // 时间点较多时在拉普拉斯空间建立插值缓存，核函数调用次数与时间点数无关
+    const LaplaceInverter* inverter = ctx.inverter;
+    int calls = inverter->kernelCalls();
+    bool useCache = (ctx.laplaceCache > 0)
+                    || (ctx.laplaceCache < 0 && activePoints * calls >= LAPLACE_CACHE_AUTO_CALLS);
+    if (!useCache || activePoints == 0) return false;
+
+    // 覆盖全部反演节点的 z 范围
+    double zLo[LaplaceInverter::MAX_KERNEL_CALLS], zHi[LaplaceInverter::MAX_KERNEL_CALLS];
+    inverter->nodes(tMax, zLo);
+    inverter->nodes(tMin, zHi);
+    double zMin = *std::min_element(zLo, zLo + calls);
+    double zMax = *std::max_element(zHi, zHi + calls);
+    return cache.build(zMin, zMax, [&](const double* z, double* values, int n) {
+        ParallelFor::run(n, [&](int i) { values[i] = kernel(z[i]); });
+    });
+}
+
+template <class Kernel>
+int ModelSolver01_06::invertCurve(const QVector<double>& tD, const EvalContext& ctx, const Kernel& kernel,
+                                  QVector<double>& outPD, QVector<double>& outDeriv)
+{
+    int numPoints = tD.size();
+    outPD.resize(numPoints);
+    outDeriv.resize(numPoints);
+
+    double tMin = 0.0, tMax = 0.0;
+    int activePoints = 0;
+    for (double t : tD) {
+        if (t <= 1e-12) continue;
+        if (activePoints == 0 || t < tMin) tMin = t;
+        if (activePoints == 0 || t > tMax) tMax = t;
+        ++activePoints;
+    }
+
+    LaplaceSpaceCache cache;
+    bool useCache = buildLaplaceCache(tMin, tMax, activePoints, ctx, kernel, cache);
+    const LaplaceSpaceCache* cachePtr = useCache ? &cache : nullptr;
+
+    // 各时间点的反演相互独立：分发到专用线程池并行计算，结果按索引写回，顺序与串行一致
+    double* pdData = outPD.data();
+    ParallelFor::run(numPoints, [&](int k) {
+        pdData[k] = invertPoint(tD[k], ctx, kernel, cachePtr);
+    });
+
+    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
+    else outDeriv.fill(0.0);
+
+    return useCache ? cache.kernelCalls() : activePoints * ctx.inverter->kernelCalls();
+}
+
+bool ModelSolver01_06::sameDimensionlessProblem(const EvalContext& a, const EvalContext& b)
+{
+    const KernelParams& x = a.kernel;
+    const KernelParams& y = b.kernel;
+    return a.inverter == b.inverter && a.laplaceCache == b.laplaceCache && a.gamaD == b.gamaD
+           && x.type == y.type && x.M12 == y.M12 && x.LfD == y.LfD && x.rmD == y.rmD && x.reD == y.reD
+           && x.omega1 == y.omega1 && x.omega2 == y.omega2 && x.lambda1 == y.lambda1
+           && x.applyStorage == y.applyStorage && (!x.applyStorage || (x.cD == y.cD && x.S == y.S))
+           && x.nf == y.nf && x.xwD == y.xwD && x.ywD == y.ywD;
+}
+
+BatchCurveData ModelSolver01_06::calculateTheoreticalCurves(const ParameterBatch& batch, const QVector<double>& providedTime,
+                                                           bool highPrecision, const std::atomic<bool>* cancel) const
+{
+    BatchCurveData out;
+    out.t = providedTime;
+    if (out.t.isEmpty()) {
+        out.t = generateLogTimeSteps(100, -3.0, 3.0);
+    }
+    int numPoints = out.t.size();
+    int count = batch.size;
+    out.size = count;
+    out.pressure.resize((qint64)count * numPoints);
+    out.derivative.resize((qint64)count * numPoints);
+
+    // 1. 每组只解析一次参数；无量纲问题相同的组归为一类 (各组的 tD 与压力系数仍各自计算)
+    QVector<EvalContext> contexts(count);
+    QVector<QVector<double>> tD(count);
+    QVector<double> factors(count);
+    QVector<int> groupOf(count);
+    QVector<int> groupLeader;
+    for (int i = 0; i < count; ++i) {
+        QMap<QString, double> params = batch.at(i);
+        contexts[i] = makeContext(params, highPrecision);
+        tD[i] = dimensionlessTime(params, out.t);
+        factors[i] = pressureFactor(params);
+        groupOf[i] = -1;
+        for (int g = 0; g < groupLeader.size() && groupOf[i] < 0; ++g) {
+            if (sameDimensionlessProblem(contexts[groupLeader[g]], contexts[i])) groupOf[i] = g;
+        }
+        if (groupOf[i] < 0) {
+            groupOf[i] = groupLeader.size();
+            groupLeader.append(i);
+        }
+    }
+
+    // 2. 各类按其全部组的时间点决定是否建立拉普拉斯空间插值缓存 (同类的像函数只计算一次)
+    int groups = groupLeader.size();
+    std::vector<LaplaceSpaceCache> caches(groups);
+    QVector<bool> useCache(groups, false);
+    QVector<int> groupCalls(groups, 0);
+    for (int g = 0; g < groups; ++g) {
+        const EvalContext& ctx = contexts[groupLeader[g]];
+        double tMin = 0.0, tMax = 0.0;
+        int activePoints = 0;
+        for (int i = 0; i < count; ++i) {
+            if (groupOf[i] != g) continue;
+            for (double t : tD[i]) {
+                if (t <= 1e-12) continue;
+                if (activePoints == 0 || t < tMin) tMin = t;
+                if (activePoints == 0 || t > tMax) tMax = t;
+                ++activePoints;
+            }
+        }
+        if (cancel && cancel->load(std::memory_order_relaxed)) return out;
+        const KernelParams& kp = ctx.kernel;
+        useCache[g] = buildLaplaceCache(tMin, tMax, activePoints, ctx,
+                                        [&kp](double z) { return flaplace_composite(z, kp); }, caches[g]);
+        groupCalls[g] = useCache[g] ? caches[g].kernelCalls() : activePoints * ctx.inverter->kernelCalls();
+    }
+    for (int calls : groupCalls) out.kernelCalls += calls;
+
+    // 3. 全部 (组, 时间点) 在一次并行循环中反演，结果直接写入连续缓冲区
+    // (各线程只读访问下列数组，先取得数据指针，避免并行访问时触发隐式共享的检查)
+    const EvalContext* ctxData = contexts.constData();
+    const QVector<double>* tDData = tD.constData();
+    const int* groupData = groupOf.constData();
+    const bool* cacheData = useCache.constData();
+    double* pData = out.pressure.data();
+    ParallelFor::run(count * numPoints, [&](int k) {
+        int i = k / numPoints;
+        int g = groupData[i];
+        const KernelParams& kp = ctxData[i].kernel;
+        pData[k] = invertPoint(tDData[i].at(k % numPoints), ctxData[i], [&kp](double z) { return flaplace_composite(z, kp); },
+                               cacheData[g] ? &caches[g] : nullptr);
+    }, cancel);
+    if (cancel && cancel->load(std::memory_order_relaxed)) return out;
+
+    // 4. 各组在自己的 tD 上求 Bourdet 导数，再换算为有量纲压力
+    const double* factorData = factors.constData();
+    double* dData = out.derivative.data();
+    ParallelFor::run(count, [&](int i) {
+        double* p = pData + (qint64)i * numPoints;
+        double* d = dData + (qint64)i * numPoints;
+        QVector<double> pd(numPoints);
+        std::copy(p, p + numPoints, pd.begin());
+        QVector<double> deriv = (numPoints > 2) ? PressureDerivativeCalculator::calculateBourdetDerivative(tDData[i], pd, 0.1)
+                                                : QVector<double>(numPoints, 0.0);
+        for (int j = 0; j < numPoints; ++j) {
+            p[j] = factorData[i] * pd[j];
+            d[j] = factorData[i] * deriv[j];
+        }
+    }, cancel);
+
+    return out;
+}
+
+template <class Scalar>
+Scalar ModelSolver01_06::flaplace_composite(const Scalar& z, const KernelParamsT<Scalar>& kp) {
+    Scalar temp = kp.omega2;
+    Scalar fs1 = kp.omega1 + kp.lambda1 * temp / (kp.lambda1 + z * temp);
+    Scalar fs2 = kp.M12 * temp;
+
+    // 调用通用 PWD 计算内核，内部包含边界判断逻辑
+    Scalar pf = PWD_composite(z, fs1, fs2, kp);
+
+    // 考虑井筒储存和表皮 (对应 MATLAB: (z*pf+S)/(z+CD*z^2*(z*pf+S)))
+    if (kp.applyStorage) {
+        pf = (z * pf + kp.S) / (z + kp.cD * z * z * (z * pf + kp.S));
+    }
+
+    return pf;
+}
+
+template <class Scalar>
+Scalar ModelSolver01_06::PWD_composite(const Scalar& z, const Scalar& fs1, const Scalar& fs2, const KernelParamsT<Scalar>& kp) {
+    using std::sqrt;
+    using std::exp;
+    const Scalar& M12 = kp.M12;
+    const Scalar& LfD = kp.LfD;
+    const Scalar& rmD = kp.rmD;
+    const Scalar& reD = kp.reD;
+    const int nf = kp.nf;
+    const ModelType type = kp.type;
+    const QVector<double>& xwD = kp.xwD;
+    const QVector<double>& ywD = kp.ywD;
+    Scalar gama1 = sqrt(z * fs1);
+    Scalar gama2 = sqrt(z * fs2);
+    Scalar arg_g2_rm = gama2 * rmD;
+    Scalar arg_g1_rm = gama1 * rmD;
+
+    bool isInfinite = isInfiniteBoundary(type);
+    bool isClosed = (type == Model_3 || type == Model_4);
+    bool isConstP = (type == Model_5 || type == Model_6);
+
+    // 使用缩放贝塞尔函数以避免数值溢出
+    // rmD 处两个自变量与 reD 处的自变量一次批量计算 I0/I1/K0/K1
+    Scalar arg_re = gama2 * reD;
+    const Scalar bessel_args[3] = { arg_g2_rm, arg_g1_rm, arg_re };
+    Scalar i0s[3], i1s[3], k0s[3], k1s[3];
+    besselScaled(bessel_args, isInfinite ? 2 : 3, i0s, i1s, k0s, k1s);
+
+    Scalar k0_g2 = k0s[0] * exp(-arg_g2_rm);
+    Scalar k1_g2 = k1s[0] * exp(-arg_g2_rm);
+    Scalar k0_g1 = k0s[1] * exp(-arg_g1_rm);
+    Scalar k1_g1 = k1s[1] * exp(-arg_g1_rm);
+
+    // --- 边界条件因子计算 mAB ---
+    // MATLAB 对应关系:
+    // Infinite: mAB = 0
+    // Closed:   mAB = K1(re)/I1(re)
+    // ConstP:   mAB = -K0(re)/I0(re)
+
+    Scalar term_mAB_i0 = 0.0;
+    Scalar term_mAB_i1 = 0.0;
+
+    if (!isInfinite) {
+        Scalar i1_re_s = i1s[2];
+        Scalar i0_re_s = i0s[2];
+        Scalar k1_re = k1s[2] * exp(-arg_re);
+        Scalar k0_re = k0s[2] * exp(-arg_re);
+        Scalar i0_g2_s = i0s[0];
+        Scalar i1_g2_s = i1s[0];
+
+        if (isClosed) {
+            // 封闭边界: ratio based on K1/I1
+            if (primalValue(i1_re_s) > 1e-100) {
+                // 计算 mAB * I0(g2*rmD) 和 mAB * I1(g2*rmD)
+                // 引入 exp(arg_g2_rm - arg_re) 来处理指数项的缩放
+                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * exp(arg_g2_rm - arg_re);
+                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * exp(arg_g2_rm - arg_re);
+            }
+        } else if (isConstP) {
+            // 定压边界: ratio based on -K0/I0
+            if (primalValue(i0_re_s) > 1e-100) {
+                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * exp(arg_g2_rm - arg_re);
+                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * exp(arg_g2_rm - arg_re);
+            }
+        }
+    }
+
+    // MATLAB: Acup = M12*gama1*K1(g1)*(mAB*I0(g2)+K0(g2)) + gama2*K0(g1)*(mAB*I1(g2)-K1(g2))
+    Scalar term1 = term_mAB_i0 + k0_g2; // (mAB*I0 + K0)
+    Scalar term2 = term_mAB_i1 - k1_g2; // (mAB*I1 - K1)
+
+    Scalar Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
+
+    Scalar i1_g1_s = i1s[1];
+    Scalar i0_g1_s = i0s[1];
+
+    // MATLAB: Acdown = M12*gama1*I1(g1)*(...) - gama2*I0(g1)*(...)
+    // 我们这里计算 scaled 版本 Acdown * exp(-arg_g1_rm)
+    Scalar Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
+
+    if (std::abs(primalValue(Acdown_scaled)) < 1e-100) Acdown_scaled = 1e-100;
+
+    // Ac = Acup / Acdown
+    // Ac_prefactor = Acup / Acdown_scaled = Ac * exp(arg_g1_rm)
+    Scalar Ac_prefactor = Acup / Acdown_scaled;
+
+    // 裂缝影响矩阵 A (nf x nf，按列存储)，常见裂缝条数下使用栈上缓冲区
+    Scalar A_buf[MAX_FIXED_FRACTURES * MAX_FIXED_FRACTURES];
+    QVector<Scalar> A_heap;
+    Scalar* A = A_buf;
+    if (nf > MAX_FIXED_FRACTURES) { A_heap.resize(nf * nf); A = A_heap.data(); }
+    auto A_mat = [A, nf](int i, int j) -> Scalar& { return A[i + j * nf]; };
+
+    // 裂缝 j 对裂缝 i 的影响系数，只与两条裂缝中心的相对位置 (dx, dy) 有关
+    auto influence = [&](double dx, double dy) -> Scalar {
+        if (dy == 0.0) {
+            // 共线裂缝: 距离 |dx - a| 为线性函数，K0 与 I0 沿裂缝段的积分使用闭式积分核
+            // 令 u = gama1*(a - dx)，Ac*I0 项与下方被积函数相同地并入 exp(-arg_g1_rm) 缩放
+            Scalar lo = gama1 * (-LfD - dx);
+            Scalar hi = gama1 * (LfD - dx);
+            Scalar val = (lineSegmentK0(lo, hi)
+                          + Ac_prefactor * lineSegmentI0(lo, hi, arg_g1_rm)) / gama1;
+            return z * val / (M12 * z * 2 * LfD);
+        }
+
+        // 不共线时 (dy != 0) 被积函数无奇点，仍使用自适应高斯积分
+        // 积分核函数: K0 + Ac*I0，一个 Gauss 区间的全部节点批量计算 Bessel 函数
+        auto integrand = [&](const double* a, Scalar* f, int n) {
+            Scalar args[GAUSS_NODES], i0[GAUSS_NODES], k0[GAUSS_NODES];
+            for (int q = 0; q < n; ++q) {
+                double dist = std::sqrt(std::pow(dx - a[q], 2) + std::pow(dy, 2));
+                Scalar arg_dist = gama1 * dist; if (primalValue(arg_dist) < 1e-10) arg_dist = 1e-10;
+                args[q] = arg_dist;
+            }
+            besselScaled(args, n, i0, (Scalar*)nullptr, k0, (Scalar*)nullptr);
+            for (int q = 0; q < n; ++q) {
+                // 计算 Ac * I0(g1*dist)
+                // = (Ac_prefactor * exp(-arg_g1_rm)) * (scaled_I0 * exp(arg_dist))
+                // = Ac_prefactor * scaled_I0 * exp(arg_dist - arg_g1_rm)
+                Scalar term2 = 0.0;
+                Scalar exponent = args[q] - arg_g1_rm;
+                if (primalValue(exponent) > -700.0) {
+                    term2 = Ac_prefactor * i0[q] * exp(exponent);
+                }
+                f[q] = k0[q] * exp(-args[q]) + term2;
+            }
+        };
+        double lfd = primalValue(LfD);
+        Scalar val = adaptiveGauss<Scalar>(integrand, -lfd, lfd, 1e-5, 0, 10);
+        if (hasTangents(LfD)) {
+            // 积分限 ±LfD 随参数变化: d/dLfD ∫(-LfD..LfD) f = f(LfD) + f(-LfD)
+            const double ends[2] = { -lfd, lfd };
+            Scalar fEnds[2];
+            integrand(ends, fEnds, 2);
+            val += (fEnds[0] + fEnds[1]) * (LfD - lfd);
+        }
+        return z * val / (M12 * z * 2 * LfD);
+    };
+
+    if (kp.uniformLayout) {
+        // 等间距且共线: A(i,j) 只依赖 |i-j| (积分区间关于 0 对称，dx 与 -dx 的积分相等)
+        // 对称 Toeplitz 矩阵，只需计算第一列的 nf 个积分，其余列由第一列复制
+        double spacing = (nf > 1) ? (xwD[1] - xwD[0]) : 0.0;
+        for (int k = 0; k < nf; ++k) A_mat(k, 0) = influence(k * spacing, 0.0);
+        for (int j = 1; j < nf; ++j) {
+            for (int i = 0; i < nf; ++i) A_mat(i, j) = A_mat(std::abs(i - j), 0);
+        }
+    } else {
+        // 非均匀布缝: 逐项组装
+        for (int i = 0; i < nf; ++i) {
+            for (int j = 0; j < nf; ++j) {
+                A_mat(i, j) = influence(xwD[i] - xwD[j], ywD[i] - ywD[j]);
+            }
+        }
+    }
+    // 流量条件 (加边行列) 在求解中解析处理
+    return solveFractureSystem(A, nf, z);
+}
+
+bool ModelSolver01_06::isUniformFractureLayout(const QVector<double>& xwD, const QVector<double>& ywD) {
+    int nf = xwD.size();
+    if (ywD.size() != nf) return false;
+    if (nf <= 1) return true;
+    double spacing = xwD[1] - xwD[0];
+    double tol = 1e-9 * std::max(std::abs(spacing), 1e-12);
+    for (int k = 0; k < nf; ++k) {
+        if (ywD[k] != ywD[0]) return false;
+        if (k > 0 && std::abs((xwD[k] - xwD[k - 1]) - spacing) > tol) return false;
+    }
+    return true;
+}
+template <class Scalar, class Integrand>
+Scalar ModelSolver01_06::gauss15(const Integrand& f, double a, double b) {
+    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
+    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
+    double h = 0.5 * (b - a); double c = 0.5 * (a + b);
+    // 节点顺序: c, c-dx1, c+dx1, c-dx2, c+dx2, ...
+    double nodes[GAUSS_NODES];
+    Scalar values[GAUSS_NODES];
+    nodes[0] = c;
+    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; nodes[2 * i - 1] = c - dx; nodes[2 * i] = c + dx; }
+    f(nodes, values, GAUSS_NODES);
+    Scalar s = W[0] * values[0];
+    for (int i = 1; i < 8; ++i) s += W[i] * (values[2 * i - 1] + values[2 * i]);
+    return s * h;
+}
+template <class Scalar, class Integrand>
+Scalar ModelSolver01_06::adaptiveGauss(const Integrand& f, double a, double b, double eps, int depth, int maxDepth) {
+    double c = (a + b) / 2.0; Scalar v1 = gauss15<Scalar>(f, a, b); Scalar v2 = gauss15<Scalar>(f, a, c) + gauss15<Scalar>(f, c, b);
+    if (depth >= maxDepth || std::abs(primalValue(v1 - v2)) < 1e-10 * std::abs(primalValue(v2)) + eps) return v2;
+    return adaptiveGauss<Scalar>(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss<Scalar>(f, c, b, eps/2, depth+1, maxDepth);
+}
@@ -0,0 +1,233 @@
+/*
+ * modelsolver01-06.h
+ * 文件作用：压裂水平井复合页岩油模型 (模型1-6) 计算内核头文件
+ * 功能描述：
+ * 1. 从 ModelWidget01_06 中拆分出的无界面计算引擎，不依赖任何 QWidget
+ * 2. 拉普拉斯空间解、Stehfest 反演、Bessel 函数与数值积分均在此实现
+ * 3. 所有计算接口均为 const，每次调用的设置通过只读上下文传递，
+ *    不修改任何成员状态，因此多个拟合、敏感性分析可在不同线程中同时调用
+ * 4. 拉普拉斯空间核函数对标量类型泛型：以 DualNumber 为标量计算一遍即得到曲线对参数的偏导数
+ * 5. 理论曲线可按固定对数网格计算，也可自适应采样 (平缓段稀疏，井储驼峰与边界过渡段加密)
+ */
+
+#ifndef MODELSOLVER01_06_H
+#define MODELSOLVER01_06_H
+
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <tuple>
+#include <atomic>
+
+class LaplaceInverter;
+class LaplaceSpaceCache;
+class DualNumber;
+
+// 类型定义: <时间, 压力, 导数>
+using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
+
+// 批量计算的参数块 (结构数组): 各组共同的参数放在 base 中，各组不同的参数按列存放，每列 size 个取值
+struct ParameterBatch
+{
+    QMap<QString, double> base;
+    QMap<QString, QVector<double>> columns;
+    int size = 0;
+
+    // 设置一列 (第一列决定组数，其余各列的长度须与之相同)
+    void setColumn(const QString& name, const QVector<double>& values);
+    // 第 i 组的完整参数表；列中含 L 或 Lf 时按 LfD = Lf / L 联动
+    QMap<QString, double> at(int i) const;
+};
+
+// 批量计算结果: 各组共用时间序列，压力与导数按 [组][时间点] 连续存放
+struct BatchCurveData
+{
+    QVector<double> t;
+    QVector<double> pressure;      // size × t.size() 个
+    QVector<double> derivative;
+    int size = 0;
+    int kernelCalls = 0;           // 全部组实际的核函数调用次数
+
+    const double* pressureOf(int i) const { return pressure.constData() + (qint64)i * t.size(); }
+    const double* derivativeOf(int i) const { return derivative.constData() + (qint64)i * t.size(); }
+    // 复制出第 i 组的曲线
+    ModelCurveData curve(int i) const;
+};
+
+class ModelSolver01_06
+{
+public:
+    enum ModelType {
+        Model_1 = 0, // 无限大 + 变井储
+        Model_2,     // 无限大 + 恒定井储
+        Model_3,     // 封闭边界 + 变井储
+        Model_4,     // 封闭边界 + 恒定井储
+        Model_5,     // 定压边界 + 变井储
+        Model_6      // 定压边界 + 恒定井储
+    };
+
+    // 核函数参数块：每条曲线由参数表解析一次，派生量 (M12、裂缝位置等) 预先算好，
+    // 拉普拉斯空间核函数内不再做字符串查找，也不再构造临时容器
+    // Scalar 为 DualNumber 时连续参数携带对拟合参数的方向导数
+    template <class Scalar>
+    struct KernelParamsT {
+        ModelType type;          // 模型类型 (决定边界条件与井储)
+        Scalar M12;              // kf / km
+        Scalar LfD;
+        Scalar rmD;
+        Scalar reD;              // 0 表示无限大 (如果未设置)
+        Scalar omega1;
+        Scalar omega2;
+        Scalar lambda1;
+        Scalar cD;
+        Scalar S;
+        bool applyStorage;       // 变井储模型且 CD/S 非零时考虑井储与表皮
+        int nf;
+        QVector<double> xwD;     // 裂缝中心位置
+        QVector<double> ywD;
+        bool uniformLayout;      // 裂缝等间距共线 (影响矩阵为 Toeplitz 矩阵)
+    };
+    using KernelParams = KernelParamsT<double>;
+
+    // 单次计算的只读上下文：在计算开始前一次性确定，计算过程中不再修改
+    struct EvalContext {
+        const LaplaceInverter* inverter;     // 拉普拉斯反演后端 (共享只读实例)
+        int laplaceCache;                    // 拉普拉斯空间插值缓存: 0 关闭，1 开启，-1 按计算量自动选择
+        double gamaD;                        // 压敏系数
+        KernelParams kernel;                 // 核函数参数块
+    };
+
+    // 自适应采样的默认设置
+    static constexpr double ADAPTIVE_TOLERANCE = 0.005;       // 插值误差容限 (log10，约 1.2%)
+    static constexpr double ADAPTIVE_MIN_SPACING = 0.01;      // 最小点距 (对数周期)
+    static const int ADAPTIVE_COARSE_PER_CYCLE = 2;          // 初始网格每个对数周期的点数
+
+    explicit ModelSolver01_06(ModelType type);
+
+    ModelType type() const { return m_type; }
+
+    // 计算理论曲线 (可重入)
+    // 反演方法由参数 "LaplaceMethod" 选择 (0 = Stehfest，1 = Gaver-Wynn-Rho)，默认 Stehfest
+    // highPrecision = true 时使用参数中的 N (对应 MATLAB 中的 N=8)，否则固定使用 N=4
+    // N 即每个时间点的核函数调用次数
+    // 参数 "LaplaceCache" 控制拉普拉斯空间插值缓存 (0 关闭，1 开启，默认按时间点数自动开启)
+    // kernelCalls 不为空时返回本次计算实际的核函数调用次数
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             bool highPrecision = true,
+                                             int* kernelCalls = nullptr) const;
+
+    // 计算理论曲线及其对 names 中各参数的偏导数 (前向自动微分，一遍计算得到全部偏导数)
+    // dP[k][i]、dDP[k][i] 为第 i 个时间点的压力、压力导数对 names[k] 的偏导数
+    // 参数表同时含 L 与 Lf 时 LfD 视为 Lf/L，对 L、Lf 的偏导数包含经 LfD 传递的部分；nf 为离散参数，偏导数为 0
+    // 求导计算不使用拉普拉斯空间插值缓存
+    // cancel 不为空且被置位后尚未开始的计算不再执行，此时返回的结果不完整，调用方应丢弃
+    ModelCurveData calculateCurveSensitivities(const QMap<QString, double>& params,
+                                               const QStringList& names,
+                                               const QVector<double>& providedTime,
+                                               bool highPrecision,
+                                               QVector<QVector<double>>& dP,
+                                               QVector<QVector<double>>& dDP,
+                                               const std::atomic<bool>* cancel = nullptr) const;
+
+    // 批量计算多组参数在同一时间序列上的理论曲线 (可重入)
+    // 每组只解析一次参数，全部 (组, 时间点) 在一次并行循环中反演；
+    // 无量纲问题相同的组 (只改变 phi、h、q、kf 等换算参数) 共用拉普拉斯空间插值缓存，像函数只计算一次
+    // cancel 不为空且被置位后返回的结果不完整，调用方应丢弃
+    BatchCurveData calculateTheoreticalCurves(const ParameterBatch& batch,
+                                              const QVector<double>& providedTime = QVector<double>(),
+                                              bool highPrecision = true,
+                                              const std::atomic<bool>* cancel = nullptr) const;
+
+    // 自适应采样计算 [tMin, tMax] 上的理论曲线 (可重入)
+    // 从每个对数周期 ADAPTIVE_COARSE_PER_CYCLE 个点的粗网格出发，逐轮在双对数坐标下压力或导数的
+    // 线性插值误差估计 (|y''| h² / 8) 超过 tolerance (对数周期) 的区间插入中点，直到全部区间满足要求、
+    // 区间宽度达到 ADAPTIVE_MIN_SPACING 或总点数达到 maxPoints
+    // cancel 不为空且被置位后不再细分，此时返回的结果不完整，调用方应丢弃
+    ModelCurveData calculateAdaptiveCurve(const QMap<QString, double>& params, double tMin, double tMax,
+                                          int maxPoints, double tolerance = ADAPTIVE_TOLERANCE,
+                                          bool highPrecision = true, int* kernelCalls = nullptr,
+                                          const std::atomic<bool>* cancel = nullptr) const;
+
+    // 计算无量纲曲线: tD 上的 pD 及其 Bourdet 导数 (不做有量纲换算)，返回核函数调用次数
+    int calculateDimensionlessCurve(const QMap<QString, double>& params, const QVector<double>& tD, bool highPrecision,
+                                    QVector<double>& pD, QVector<double>& dpD) const;
+
+    // 根据参数构造本次计算的只读上下文 (ctx.inverter->kernelCalls() 为每点核函数调用次数)
+    EvalContext makeContext(const QMap<QString, double>& params, bool highPrecision) const;
+
+    // 两个上下文的无量纲计算是否完全相同 (核函数参数、压敏系数与反演设置)
+    // 相同时可放入同一批量计算，共用拉普拉斯空间插值缓存
+    static bool sameDimensionlessProblem(const EvalContext& a, const EvalContext& b);
+
+    // 有量纲换算: 时间 t (h) -> 无量纲时间 tD，以及 p = factor * pD 中的压力系数
+    static QVector<double> dimensionlessTime(const QMap<QString, double>& params, const QVector<double>& t);
+    static double pressureFactor(const QMap<QString, double>& params);
+
+    // 静态工具: 生成对数时间步长
+    static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
+
+    // 模型特性判断
+    static bool hasWellboreStorage(ModelType type);
+    static bool isInfiniteBoundary(ModelType type);
+
+    // 由参数表构造核函数参数块
+    static KernelParams makeKernelParams(ModelType type, const QMap<QString, double>& params);
+
+    // 参数块构造的通用实现: get(name, defaultValue) 返回 Scalar 类型的参数值
+    template <class Scalar, class Getter>
+    static KernelParamsT<Scalar> buildKernelParams(ModelType type, const Getter& get);
+
+private:
+    // 数学计算核心 (拉普拉斯反演循环，各时间点并行计算)，返回核函数调用次数
+    static int calculatePDandDeriv(const QVector<double>& tD, const EvalContext& ctx,
+                                   QVector<double>& outPD, QVector<double>& outDeriv);
+
+    // 反演循环本体：像函数以模板参数传入 (double(double) 可调用对象)，内层循环可直接内联
+    template <class Kernel>
+    static int invertCurve(const QVector<double>& tD, const EvalContext& ctx, const Kernel& kernel,
+                           QVector<double>& outPD, QVector<double>& outDeriv);
+
+    // 单个时间点的反演 (含压敏换算)；cache 不为空时像函数取插值
+    template <class Kernel>
+    static double invertPoint(double tD, const EvalContext& ctx, const Kernel& kernel, const LaplaceSpaceCache* cache);
+
+    // 按 ctx.laplaceCache 的设置与计算量决定是否在覆盖 [tMin, tMax] 的 z 范围上建立插值缓存，返回是否可用
+    template <class Kernel>
+    static bool buildLaplaceCache(double tMin, double tMax, int activePoints, const EvalContext& ctx,
+                                  const Kernel& kernel, LaplaceSpaceCache& cache);
+
+    // 对偶数版本的反演循环: 输出 PD 及其方向导数 (不含 Bourdet 导数)
+    static void invertCurveSensitivity(const QVector<DualNumber>& tD, const LaplaceInverter* inverter,
+                                       const DualNumber& gamaD, const KernelParamsT<DualNumber>& kp,
+                                       QVector<DualNumber>& outPD, const std::atomic<bool>* cancel);
+
+    // 自动模式下开启插值缓存的逐点计算量阈值 (时间点数 × 每点调用次数)
+    static const int LAPLACE_CACHE_AUTO_CALLS = 1600;
+
+    // 拉普拉斯空间解 (复合模型通用入口)，Scalar 为 double 或 DualNumber
+    template <class Scalar>
+    static Scalar flaplace_composite(const Scalar& z, const KernelParamsT<Scalar>& kp);
+
+    // PWD 核心计算 (包含边界条件处理 Logic from MATLAB PWD_inf)
+    template <class Scalar>
+    static Scalar PWD_composite(const Scalar& z, const Scalar& fs1, const Scalar& fs2, const KernelParamsT<Scalar>& kp);
+
+    // 裂缝是否等间距共线分布 (此时影响矩阵为对称 Toeplitz 矩阵)
+    static bool isUniformFractureLayout(const QVector<double>& xwD, const QVector<double>& ywD);
+
+    // 数学工具函数 (对应 MATLAB 内置函数或逻辑)
+    // 被积函数以模板参数传入: f(a, values, n) 一次计算 n 个节点 a[0..n-1] 上的函数值 (Scalar 类型)
+    // 自适应细分只依据函数值判断收敛
+    static const int GAUSS_NODES = 15;
+    template <class Scalar, class Integrand>
+    static Scalar gauss15(const Integrand& f, double a, double b);
+    template <class Scalar, class Integrand>
+    static Scalar adaptiveGauss(const Integrand& f, double a, double b, double eps, int depth, int maxDepth);
+
+private:
+    const ModelType m_type;
+};
+
+#endif // MODELSOLVER01_06_H
@@ -7,35 +7,35 @@
  * 4. Model 4: 压裂水平井复合页岩油 - 封闭边界 + 恒定井储 (对应 MATLAB: mAB=K1/I1, CD/S=0)
  * 5. Model 5: 压裂水平井复合页岩油 - 定压边界 + 变井储表皮 (对应 MATLAB: mAB=-K0/I0, CD/S non-zero)
  * 6. Model 6: 压裂水平井复合页岩油 - 定压边界 + 恒定井储 (对应 MATLAB: mAB=-K0/I0, CD/S=0)
+ * 数学计算内核见 modelsolver01-06.cpp，本文件只负责界面交互与绘图。
+ * 理论曲线在后台线程计算：每完成一条曲线立即绘制并更新进度，计算中再次点击计算按钮即停止。
+ * 敏感性分析可作用于任一参数，包括最大时间 t 与点数。
+ * 默认自适应采样：点数作为上限，平缓段稀疏、曲线转折处加密，导出的数据随之精简。
  */
 
 #include "modelwidget01-06.h"
 #include "ui_modelwidget01-06.h"
 #include "modelmanager.h"
-#include "pressurederivativecalculator.h"
 #include "modelparameter.h"
-
-#include <Eigen/Dense>
-#include <boost/math/special_functions/bessel.hpp>
+#include "laplaceinversion.h"
 
 #include <cmath>
-#include <algorithm>
 #include <QDebug>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QTextStream>
 #include <QDateTime>
-#include <QCoreApplication>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include <QtConcurrent>
 
 ModelWidget01_06::ModelWidget01_06(ModelType type, QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::ModelWidget01_06)
     , m_type(type)
+    , m_solver(type)
     , m_highPrecision(true)
+    , m_cancelRequested(false)
+    , m_kernelCalls(0)
+    , m_finishedCurves(0)
 {
     ui->setupUi(this);
     m_colorList = { Qt::red, Qt::blue, QColor(0,180,0), Qt::magenta, QColor(255,140,0), Qt::cyan };
@@ -46,7 +46,12 @@ ModelWidget01_06::ModelWidget01_06(ModelType type, QWidget *parent)
     onResetParameters();
 }
 
-ModelWidget01_06::~ModelWidget01_06() { delete ui; }
+ModelWidget01_06::~ModelWidget01_06() {
+    // 后台计算引用本对象的求解器与信号，须先停止
+    m_cancelRequested = true;
+    m_watcher.waitForFinished();
+    delete ui;
+}
 
 QString ModelWidget01_06::getModelName() const {
     switch(m_type) {
@@ -140,6 +145,8 @@ void ModelWidget01_06::setupConnections() {
     connect(ui->LEdit, &QLineEdit::editingFinished, this, &ModelWidget01_06::onDependentParamsChanged);
     connect(ui->LfEdit, &QLineEdit::editingFinished, this, &ModelWidget01_06::onDependentParamsChanged);
     connect(ui->checkShowPoints, &QCheckBox::toggled, this, &ModelWidget01_06::onShowPointsToggled);
+    connect(this, &ModelWidget01_06::sigCurveFinished, this, &ModelWidget01_06::onCurveFinished, Qt::QueuedConnection);
+    connect(&m_watcher, &QFutureWatcher<void>::finished, this, &ModelWidget01_06::onCalculationFinished);
 }
 
 void ModelWidget01_06::setHighPrecision(bool high) { m_highPrecision = high; }
@@ -224,17 +231,44 @@ void ModelWidget01_06::onShowPointsToggled(bool checked) {
 }
 
 void ModelWidget01_06::onCalculateClicked() {
-    ui->calculateButton->setEnabled(false);
-    ui->calculateButton->setText("计算中...");
-    QCoreApplication::processEvents();
-    runCalculation();
-    ui->calculateButton->setEnabled(true);
-    ui->calculateButton->setText("开始计算");
-}
+    // 计算进行中再次点击即为停止 (已完成的曲线保留在图上)
+    if (m_watcher.isRunning()) {
+        m_cancelRequested = true;
+        ui->calculateButton->setEnabled(false);
+        ui->calculateButton->setText("正在停止...");
+        return;
+    }
 
-void ModelWidget01_06::runCalculation() {
+    m_plan = buildCalculationPlan();
+    m_cancelRequested = false;
+    m_kernelCalls = 0;
+    m_finishedCurves = 0;
+    res_tD.clear();
+    res_pD.clear();
+    res_dpD.clear();
     m_plot->clearGraphs();
+    m_plot->replot();
+    ui->resultTextEdit->clear();
+    setCalculating(true);
+
+    // 使用 QtConcurrent 在后台线程计算，避免阻塞 UI 主线程
+    CalculationPlan plan = m_plan;
+    bool highPrecision = m_highPrecision;
+    m_watcher.setFuture(QtConcurrent::run([this, plan, highPrecision]() {
+        runCalculationTask(plan, highPrecision);
+    }));
+}
+
+void ModelWidget01_06::setCalculating(bool calculating) {
+    ui->calculateButton->setEnabled(true);
+    ui->calculateButton->setText(calculating ? "停止计算" : "开始计算");
+    ui->resetButton->setEnabled(!calculating);
+    ui->progressBar->setRange(0, m_plan.params.size);
+    ui->progressBar->setValue(0);
+    ui->progressBar->setVisible(calculating);
+}
 
+ModelWidget01_06::CalculationPlan ModelWidget01_06::buildCalculationPlan() {
     QMap<QString, QVector<double>> rawParams;
     rawParams["phi"] = parseInput(ui->phiEdit->text());
     rawParams["h"] = parseInput(ui->hEdit->text());
@@ -243,6 +277,7 @@ void ModelWidget01_06::runCalculation() {
     rawParams["Ct"] = parseInput(ui->CtEdit->text());
     rawParams["q"] = parseInput(ui->qEdit->text());
     rawParams["t"] = parseInput(ui->tEdit->text());
+    rawParams["points"] = parseInput(ui->pointsEdit->text());
 
     rawParams["kf"] = parseInput(ui->kfEdit->text());
     rawParams["km"] = parseInput(ui->kmEdit->text());
@@ -266,18 +301,19 @@ void ModelWidget01_06::runCalculation() {
         rawParams["S"] = {0.0};
     }
 
-    // 敏感性分析检测
-    QString sensitivityKey = "";
+    // 敏感性分析检测 (t 与点数只影响时间序列，同样可以作为敏感性参数)
+    CalculationPlan plan;
+    plan.adaptive = ui->checkAdaptive->isChecked();
     QVector<double> sensitivityValues;
     for(auto it = rawParams.begin(); it != rawParams.end(); ++it) {
-        if(it.key() == "t") continue;
         if(it.value().size() > 1) {
-            sensitivityKey = it.key();
+            plan.sensitivityKey = it.key();
             sensitivityValues = it.value();
             break;
         }
     }
-    bool isSensitivity = !sensitivityKey.isEmpty();
+    bool isSensitivity = !plan.sensitivityKey.isEmpty();
+    QVector<double> pointValues = rawParams.take("points");
 
     QMap<QString, double> baseParams;
     for(auto it = rawParams.begin(); it != rawParams.end(); ++it) {
@@ -287,53 +323,112 @@ void ModelWidget01_06::runCalculation() {
     if(baseParams["L"] > 1e-9) baseParams["LfD"] = baseParams["Lf"] / baseParams["L"];
     else baseParams["LfD"] = 0;
 
-    int nPoints = ui->pointsEdit->text().toInt();
-    if(nPoints < 5) nPoints = 5;
-
-    double maxTime = baseParams.value("t", 1000.0);
-    if(maxTime < 1e-3) maxTime = 1000.0;
-    QVector<double> t = ModelManager::generateLogTimeSteps(nPoints, -3.0, log10(maxTime));
-
     int iterations = isSensitivity ? sensitivityValues.size() : 1;
     iterations = qMin(iterations, (int)m_colorList.size());
+    sensitivityValues = sensitivityValues.mid(0, iterations);
 
-    QString resultTextHeader = QString("计算完成 (%1)\n").arg(getModelName());
-    if(isSensitivity) resultTextHeader += QString("敏感性参数: %1\n").arg(sensitivityKey);
+    // 被分析参数的各个取值作为一列 (L、Lf 变化时 LfD 随之联动)；点数不是模型参数，单独处理
+    plan.params.base = baseParams;
+    if (isSensitivity && plan.sensitivityKey != "points") plan.params.setColumn(plan.sensitivityKey, sensitivityValues);
+    else plan.params.size = iterations;
 
     for(int i = 0; i < iterations; ++i) {
-        QMap<QString, double> currentParams = baseParams;
-        double val = 0;
-        if (isSensitivity) {
-            val = sensitivityValues[i];
-            currentParams[sensitivityKey] = val;
-            if (sensitivityKey == "L" || sensitivityKey == "Lf") {
-                if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
-            }
+        int nPoints = (int)(plan.sensitivityKey == "points" ? sensitivityValues[i] : pointValues.first());
+        if(nPoints < 5) nPoints = 5;
+        double maxTime = plan.params.at(i).value("t", 1000.0);
+        if(maxTime < 1e-3) maxTime = 1000.0;
+        plan.times.append(ModelManager::generateLogTimeSteps(nPoints, -3.0, log10(maxTime)));
+
+        if (isSensitivity) plan.legends.append(QString("%1 = %2").arg(plan.sensitivityKey).arg(sensitivityValues[i]));
+        else plan.legends.append("理论曲线");
+    }
+    return plan;
+}
+
+/**
+ * @brief 后台计算全部曲线
+ * 说明：时间序列相同且无量纲问题相同的相邻曲线 (如只改变 phi、h、q 的敏感性分析) 并入同一次批量计算，
+ *       共用拉普拉斯空间插值缓存；其余曲线逐条计算。每批完成后立即把曲线送回界面线程绘制。
+ *       自适应采样时各曲线的时间点不同，逐条计算。
+ */
+void ModelWidget01_06::runCalculationTask(const CalculationPlan& plan, bool highPrecision) {
+    int count = plan.params.size;
+    if (plan.adaptive) {
+        for (int i = 0; i < count && !m_cancelRequested; ++i) {
+            const QVector<double>& range = plan.times[i];
+            int calls = 0;
+            ModelCurveData res = m_solver.calculateAdaptiveCurve(plan.params.at(i), range.first(), range.last(), range.size(),
+                                                                 ModelSolver01_06::ADAPTIVE_TOLERANCE, highPrecision,
+                                                                 &calls, &m_cancelRequested);
+            if (m_cancelRequested) return; // 本条曲线计算被中途取消，结果不完整
+            m_kernelCalls += calls;
+            emit sigCurveFinished(i, std::get<0>(res), std::get<1>(res), std::get<2>(res));
         }
+        return;
+    }
 
-        ModelCurveData res = calculateTheoreticalCurve(currentParams, t);
-        res_tD = std::get<0>(res);
-        res_pD = std::get<1>(res);
-        res_dpD = std::get<2>(res);
+    int i = 0;
+    while (i < count && !m_cancelRequested) {
+        ModelSolver01_06::EvalContext first = m_solver.makeContext(plan.params.at(i), highPrecision);
+        int end = i + 1;
+        while (end < count && plan.times[end] == plan.times[i]
+               && ModelSolver01_06::sameDimensionlessProblem(first, m_solver.makeContext(plan.params.at(end), highPrecision))) {
+            ++end;
+        }
+
+        ParameterBatch chunk;
+        chunk.base = plan.params.base;
+        for (auto it = plan.params.columns.constBegin(); it != plan.params.columns.constEnd(); ++it) {
+            chunk.setColumn(it.key(), it.value().mid(i, end - i));
+        }
+        if (chunk.columns.isEmpty()) chunk.size = end - i;
 
-        QColor curveColor = isSensitivity ? m_colorList[i] : Qt::red;
-        QString legendName;
-        if (isSensitivity) legendName = QString("%1 = %2").arg(sensitivityKey).arg(val);
-        else legendName = "理论曲线";
+        BatchCurveData curves = m_solver.calculateTheoreticalCurves(chunk, plan.times[i], highPrecision, &m_cancelRequested);
+        if (m_cancelRequested) return; // 本批计算被中途取消，结果不完整
+        m_kernelCalls += curves.kernelCalls;
 
-        plotCurve(res, legendName, curveColor, isSensitivity);
+        for (int k = 0; k < curves.size; ++k) {
+            ModelCurveData res = curves.curve(k);
+            emit sigCurveFinished(i + k, std::get<0>(res), std::get<1>(res), std::get<2>(res));
+        }
+        i = end;
     }
+}
 
-    QString resultText = resultTextHeader;
+void ModelWidget01_06::onCurveFinished(int index, QVector<double> t, QVector<double> p, QVector<double> d) {
+    res_tD = t;
+    res_pD = p;
+    res_dpD = d;
+
+    bool isSensitivity = !m_plan.sensitivityKey.isEmpty();
+    QColor curveColor = isSensitivity ? m_colorList[index] : Qt::red;
+    plotCurve(std::make_tuple(t, p, d), m_plan.legends[index], curveColor, isSensitivity);
+
+    ++m_finishedCurves;
+    ui->progressBar->setValue(m_finishedCurves);
+    onFitToData();
+}
+
+void ModelWidget01_06::onCalculationFinished() {
+    bool cancelled = m_cancelRequested;
+    int total = m_plan.params.size;
+    setCalculating(false);
+
+    QString resultText;
+    if (cancelled) resultText = QString("计算已停止 (%1): 完成 %2 / %3 条曲线\n").arg(getModelName()).arg(m_finishedCurves).arg(total);
+    else resultText = QString("计算完成 (%1)\n").arg(getModelName());
+    if (!m_plan.sensitivityKey.isEmpty()) resultText += QString("敏感性参数: %1\n").arg(m_plan.sensitivityKey);
+
+    const LaplaceInverter* inverter = m_solver.makeContext(m_plan.params.base, m_highPrecision).inverter;
+    resultText += QString("拉普拉斯反演: %1 (%2 条曲线共调用核函数 %3 次)\n").arg(inverter->name()).arg(m_finishedCurves).arg(m_kernelCalls.load());
+    if (m_plan.adaptive) resultText += QString("自适应采样: 最后一条曲线 %1 个时间点\n").arg(res_tD.size());
     resultText += "t(h)\t\tDp(MPa)\t\tdDp(MPa)\n";
     for(int i=0; i<res_pD.size(); ++i) {
         resultText += QString("%1\t%2\t%3\n").arg(res_tD[i],0,'e',4).arg(res_pD[i],0,'e',4).arg(res_dpD[i],0,'e',4);
     }
     ui->resultTextEdit->setText(resultText);
 
-    onFitToData();
-    onShowPointsToggled(ui->checkShowPoints->isChecked());
-    emit calculationCompleted(getModelName(), baseParams);
+    if (!cancelled) emit calculationCompleted(getModelName(), m_plan.params.base);
 }
 
 void ModelWidget01_06::plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity) {
@@ -348,6 +443,11 @@ void ModelWidget01_06::plotCurve(const ModelCurveData& data, const QString& name
     QCPGraph* graphD = m_plot->addGraph();
     graphD->setData(t, d);
 
+    if (ui->checkShowPoints->isChecked()) {
+        graphP->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, 5));
+        graphD->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, 5));
+    }
+
     if (isSensitivity) {
         graphD->setPen(QPen(color, 2, Qt::DashLine));
         graphP->setName(name);
@@ -395,249 +495,5 @@ void ModelWidget01_06::onExportImage() {
 
 ModelCurveData ModelWidget01_06::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
 {
-    QVector<double> tPoints = providedTime;
-    if (tPoints.isEmpty()) {
-        tPoints = ModelManager::generateLogTimeSteps(100, -3.0, 3.0);
-    }
-
-    double phi = params.value("phi", 0.05);
-    double mu = params.value("mu", 0.5);
-    double B = params.value("B", 1.05);
-    double Ct = params.value("Ct", 5e-4);
-    double q = params.value("q", 5.0);
-    double h = params.value("h", 20.0);
-    double kf = params.value("kf", 1e-3);
-    double L = params.value("L", 1000.0);
-
-    QVector<double> tD_vec;
-    tD_vec.reserve(tPoints.size());
-    for(double t : tPoints) {
-        double val = 14.4 * kf * t / (phi * mu * Ct * pow(L, 2));
-        tD_vec.append(val);
-    }
-
-    QVector<double> PD_vec, Deriv_vec;
-    auto func = std::bind(&ModelWidget01_06::flaplace_composite, this, std::placeholders::_1, std::placeholders::_2);
-    calculatePDandDeriv(tD_vec, params, func, PD_vec, Deriv_vec);
-
-    double factor = 1.842e-3 * q * mu * B / (kf * h);
-    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
-
-    for(int i=0; i<tPoints.size(); ++i) {
-        finalP[i] = factor * PD_vec[i];
-        finalDP[i] = factor * Deriv_vec[i];
-    }
-
-    return std::make_tuple(tPoints, finalP, finalDP);
-}
-
-void ModelWidget01_06::calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                                           std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                                           QVector<double>& outPD, QVector<double>& outDeriv)
-{
-    int numPoints = tD.size();
-    outPD.resize(numPoints);
-    outDeriv.resize(numPoints);
-
-    int N_param = (int)params.value("N", 4);
-    int N = m_highPrecision ? N_param : 4;
-    if (N % 2 != 0) N = 4;
-    double ln2 = log(2.0);
-
-    // 获取压敏系数 (MATLAB: gamaD)
-    double gamaD = params.value("gamaD", 0.0);
-
-    for (int k = 0; k < numPoints; ++k) {
-        double t = tD[k];
-        if (t <= 1e-12) { outPD[k] = 0; continue; }
-        double pd_val = 0.0;
-        for (int m = 1; m <= N; ++m) {
-            double z = m * ln2 / t;
-            double pf = laplaceFunc(z, params);
-            if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
-            pd_val += stefestCoefficient(m, N) * pf;
-        }
-        outPD[k] = pd_val * ln2 / t;
-
-        // 摄动法考虑压敏效应 (对应 MATLAB: -1/gamaD * log(1-gamaD*PD))
-        if (std::abs(gamaD) > 1e-9) {
-            double arg = 1.0 - gamaD * outPD[k];
-            if (arg > 1e-12) {
-                outPD[k] = -1.0 / gamaD * std::log(arg);
-            }
-        }
-    }
-    if (numPoints > 2) outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
-    else outDeriv.fill(0.0);
-}
-
-double ModelWidget01_06::flaplace_composite(double z, const QMap<QString, double>& p) {
-    double kf = p.value("kf");
-    double km = p.value("km");
-    double LfD = p.value("LfD");
-    double rmD = p.value("rmD");
-    double reD = p.value("reD", 0.0); // 默认0表示无限大(如果未设置)
-    double omga1 = p.value("omega1");
-    double omga2 = p.value("omega2");
-    double remda1 = p.value("lambda1");
-    int nf = (int)p.value("nf", 4); if(nf < 1) nf = 1;
-    double M12 = kf / km;
-    QVector<double> xwD;
-    if (nf == 1) { xwD.append(0.0); } else {
-        double start = -0.9; double end = 0.9; double step = (end - start) / (nf - 1);
-        for(int i=0; i<nf; ++i) xwD.append(start + i * step);
-    }
-    double temp = omga2;
-    double fs1 = omga1 + remda1 * temp / (remda1 + z * temp);
-    double fs2 = M12 * temp;
-
-    // 调用通用 PWD 计算内核，内部包含边界判断逻辑
-    double pf = PWD_composite(z, fs1, fs2, M12, LfD, rmD, reD, nf, xwD, m_type);
-
-    // 考虑井筒储存和表皮 (对应 MATLAB: (z*pf+S)/(z+CD*z^2*(z*pf+S)))
-    // 仅对变井储模型 (1, 3, 5) 启用
-    bool hasStorage = (m_type == Model_1 || m_type == Model_3 || m_type == Model_5);
-    if (hasStorage) {
-        double CD = p.value("cD", 0.0);
-        double S = p.value("S", 0.0);
-        if (CD > 1e-12 || std::abs(S) > 1e-12) {
-            pf = (z * pf + S) / (z + CD * z * z * (z * pf + S));
-        }
-    }
-
-    return pf;
-}
-
-double ModelWidget01_06::PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type) {
-    using namespace boost::math;
-    QVector<double> ywD(nf, 0.0);
-    double gama1 = sqrt(z * fs1);
-    double gama2 = sqrt(z * fs2);
-    double arg_g2_rm = gama2 * rmD;
-    double arg_g1_rm = gama1 * rmD;
-
-    // 使用缩放贝塞尔函数以避免数值溢出
-    double k0_g2 = cyl_bessel_k(0, arg_g2_rm);
-    double k1_g2 = cyl_bessel_k(1, arg_g2_rm);
-    double k0_g1 = cyl_bessel_k(0, arg_g1_rm);
-    double k1_g1 = cyl_bessel_k(1, arg_g1_rm);
-
-    // --- 边界条件因子计算 mAB ---
-    // MATLAB 对应关系:
-    // Infinite: mAB = 0
-    // Closed:   mAB = K1(re)/I1(re)
-    // ConstP:   mAB = -K0(re)/I0(re)
-
-    double term_mAB_i0 = 0.0;
-    double term_mAB_i1 = 0.0;
-
-    bool isInfinite = (type == Model_1 || type == Model_2);
-    bool isClosed = (type == Model_3 || type == Model_4);
-    bool isConstP = (type == Model_5 || type == Model_6);
-
-    if (!isInfinite) {
-        double arg_re = gama2 * reD;
-        double i1_re_s = scaled_besseli(1, arg_re);
-        double i0_re_s = scaled_besseli(0, arg_re);
-        double k1_re = cyl_bessel_k(1, arg_re);
-        double k0_re = cyl_bessel_k(0, arg_re);
-        double i0_g2_s = scaled_besseli(0, arg_g2_rm);
-        double i1_g2_s = scaled_besseli(1, arg_g2_rm);
-
-        if (isClosed) {
-            // 封闭边界: ratio based on K1/I1
-            if (i1_re_s > 1e-100) {
-                // 计算 mAB * I0(g2*rmD) 和 mAB * I1(g2*rmD)
-                // 引入 exp(arg_g2_rm - arg_re) 来处理指数项的缩放
-                term_mAB_i0 = (k1_re / i1_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = (k1_re / i1_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        } else if (isConstP) {
-            // 定压边界: ratio based on -K0/I0
-            if (i0_re_s > 1e-100) {
-                term_mAB_i0 = -(k0_re / i0_re_s) * i0_g2_s * std::exp(arg_g2_rm - arg_re);
-                term_mAB_i1 = -(k0_re / i0_re_s) * i1_g2_s * std::exp(arg_g2_rm - arg_re);
-            }
-        }
-    }
-
-    // MATLAB: Acup = M12*gama1*K1(g1)*(mAB*I0(g2)+K0(g2)) + gama2*K0(g1)*(mAB*I1(g2)-K1(g2))
-    double term1 = term_mAB_i0 + k0_g2; // (mAB*I0 + K0)
-    double term2 = term_mAB_i1 - k1_g2; // (mAB*I1 - K1)
-
-    double Acup = M12 * gama1 * k1_g1 * term1 + gama2 * k0_g1 * term2;
-
-    double i1_g1_s = scaled_besseli(1, arg_g1_rm);
-    double i0_g1_s = scaled_besseli(0, arg_g1_rm);
-
-    // MATLAB: Acdown = M12*gama1*I1(g1)*(...) - gama2*I0(g1)*(...)
-    // 我们这里计算 scaled 版本 Acdown * exp(-arg_g1_rm)
-    double Acdown_scaled = M12 * gama1 * i1_g1_s * term1 - gama2 * i0_g1_s * term2;
-
-    if (std::abs(Acdown_scaled) < 1e-100) Acdown_scaled = 1e-100;
-
-    // Ac = Acup / Acdown
-    // Ac_prefactor = Acup / Acdown_scaled = Ac * exp(arg_g1_rm)
-    double Ac_prefactor = Acup / Acdown_scaled;
-
-    // 求解线性方程组
-    int size = nf + 1;
-    Eigen::MatrixXd A_mat(size, size);
-    Eigen::VectorXd b_vec(size);
-    b_vec.setZero(); b_vec(nf) = 1.0;
-
-    for (int i = 0; i < nf; ++i) {
-        for (int j = 0; j < nf; ++j) {
-            // 积分核函数: K0 + Ac*I0
-            auto integrand = [&](double a) -> double {
-                double dist = std::sqrt(std::pow(xwD[i] - xwD[j] - a, 2) + std::pow(ywD[i] - ywD[j], 2));
-                double arg_dist = gama1 * dist; if (arg_dist < 1e-10) arg_dist = 1e-10;
-
-                // 计算 Ac * I0(g1*dist)
-                // = (Ac_prefactor * exp(-arg_g1_rm)) * (scaled_I0 * exp(arg_dist))
-                // = Ac_prefactor * scaled_I0 * exp(arg_dist - arg_g1_rm)
-                double term2 = 0.0;
-                double exponent = arg_dist - arg_g1_rm;
-                if (exponent > -700.0) {
-                    term2 = Ac_prefactor * scaled_besseli(0, arg_dist) * std::exp(exponent);
-                }
-                return cyl_bessel_k(0, arg_dist) + term2;
-            };
-            double val = adaptiveGauss(integrand, -LfD, LfD, 1e-5, 0, 10);
-            A_mat(i, j) = z * val / (M12 * z * 2 * LfD);
-        }
-    }
-    // 流量条件
-    for (int i = 0; i < nf; ++i) { A_mat(i, nf) = -1.0; A_mat(nf, i) = z; }
-    A_mat(nf, nf) = 0.0;
-
-    return A_mat.fullPivLu().solve(b_vec)(nf);
-}
-
-double ModelWidget01_06::scaled_besseli(int v, double x) {
-    if (x < 0) x = -x;
-    if (x > 600.0) return 1.0 / std::sqrt(2.0 * M_PI * x);
-    return boost::math::cyl_bessel_i(v, x) * std::exp(-x);
-}
-double ModelWidget01_06::gauss15(std::function<double(double)> f, double a, double b) {
-    static const double X[] = { 0.0, 0.201194, 0.394151, 0.570972, 0.724418, 0.848207, 0.937299, 0.987993 };
-    static const double W[] = { 0.202578, 0.198431, 0.186161, 0.166269, 0.139571, 0.107159, 0.070366, 0.030753 };
-    double h = 0.5 * (b - a); double c = 0.5 * (a + b); double s = W[0] * f(c);
-    for (int i = 1; i < 8; ++i) { double dx = h * X[i]; s += W[i] * (f(c - dx) + f(c + dx)); }
-    return s * h;
-}
-double ModelWidget01_06::adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth) {
-    double c = (a + b) / 2.0; double v1 = gauss15(f, a, b); double v2 = gauss15(f, a, c) + gauss15(f, c, b);
-    if (depth >= maxDepth || std::abs(v1 - v2) < 1e-10 * std::abs(v2) + eps) return v2;
-    return adaptiveGauss(f, a, c, eps/2, depth+1, maxDepth) + adaptiveGauss(f, c, b, eps/2, depth+1, maxDepth);
-}
-double ModelWidget01_06::stefestCoefficient(int i, int N) {
-    double s = 0.0; int k1 = (i + 1) / 2; int k2 = std::min(i, N / 2);
-    for (int k = k1; k <= k2; ++k) {
-        double num = pow(k, N / 2.0) * factorial(2 * k);
-        double den = factorial(N / 2 - k) * factorial(k) * factorial(k - 1) * factorial(i - k) * factorial(2 * k - i);
-        if(den!=0) s += num/den;
-    }
-    return ((i + N / 2) % 2 == 0 ? 1.0 : -1.0) * s;
+    return m_solver.calculateTheoreticalCurve(params, providedTime, m_highPrecision);
 }
-double ModelWidget01_06::factorial(int n) { if(n<=1)return 1; double r=1; for(int i=2;i<=n;++i)r*=i; return r; }
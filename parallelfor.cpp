@@ -0,0 +1,102 @@
+/*
+ * parallelfor.cpp
+ * 文件作用：模型计算专用的并行循环工具实现文件
+ */
+
+#include "parallelfor.h"
+
+#include <QMutex>
+#include <QRunnable>
+#include <QThread>
+#include <QWaitCondition>
+#include <memory>
+#include <algorithm>
+
+namespace {
+
+// 共享的循环状态：所有参与线程从同一个计数器领取下一个索引
+// 由 shared_ptr 管理，保证最后一个辅助任务退出前状态 (含互斥量) 一直有效
+struct LoopState {
+    int count;
+    const std::function<void(int)>* body;
+    const std::atomic<bool>* cancel;
+    std::atomic<int> next;
+    QMutex mutex;
+    QWaitCondition idle;
+    int active = 0;               // 正在执行 work() 的辅助任务数 (受 mutex 保护)
+    bool closed = false;          // 调用线程已完成领取，之后开始的任务不再参与 (受 mutex 保护)
+
+    void work() {
+        for (;;) {
+            int i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) return;
+            if (cancel && cancel->load(std::memory_order_relaxed)) return;
+            (*body)(i);
+        }
+    }
+};
+
+// 辅助任务由线程池持有并在执行后自动释放，调用方不保留任务指针
+// 循环未结束时登记为活动任务后领取索引，退出时注销，最后一个退出的任务唤醒调用线程；
+// 循环已结束后才开始的任务不登记、不访问 body，直接返回
+class LoopTask : public QRunnable
+{
+public:
+    explicit LoopTask(const std::shared_ptr<LoopState>& state) : m_state(state) {}
+    void run() override {
+        {
+            QMutexLocker locker(&m_state->mutex);
+            if (m_state->closed) return;
+            ++m_state->active;
+        }
+        m_state->work();
+        QMutexLocker locker(&m_state->mutex);
+        if (--m_state->active == 0) m_state->idle.wakeAll();
+    }
+private:
+    std::shared_ptr<LoopState> m_state;
+};
+
+} // namespace
+
+QThreadPool* ParallelFor::pool()
+{
+    static QThreadPool* s_pool = []() {
+        QThreadPool* p = new QThreadPool();
+        p->setMaxThreadCount(QThread::idealThreadCount());
+        return p;
+    }();
+    return s_pool;
+}
+
+void ParallelFor::run(int count, const std::function<void(int)>& body, const std::atomic<bool>* cancel)
+{
+    if (count <= 0) return;
+
+    QThreadPool* tp = pool();
+    int helpers = std::min(tp->maxThreadCount(), count) - 1;
+    if (helpers <= 0) {
+        for (int i = 0; i < count; ++i) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) return;
+            body(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<LoopState>();
+    state->count = count;
+    state->body = &body;
+    state->cancel = cancel;
+    state->next.store(0);
+
+    for (int h = 0; h < helpers; ++h) tp->start(new LoopTask(state));
+
+    // 调用线程同样领取任务
+    state->work();
+
+    // 等待全部已登记的辅助任务退出 work()；仍在队列中的任务 (例如线程池已被外层并行循环占满)
+    // 之后开始时会看到 closed 并立即返回，不再访问 body 与调用方的输出
+    QMutexLocker locker(&state->mutex);
+    state->closed = true;
+    while (state->active > 0) state->idle.wait(&state->mutex);
+}
@@ -0,0 +1,30 @@
+/*
+ * parallelfor.h
+ * 文件作用：模型计算专用的并行循环工具头文件
+ * 功能描述：
+ * 1. 提供专用线程池，避免与界面使用的 QThreadPool::globalInstance() 相互抢占
+ * 2. 以动态取任务的方式把 [0, count) 的索引分配给各线程，负载不均时空闲线程自动领取剩余任务
+ * 3. 调用线程本身也参与计算；嵌套调用时未开始的子任务由调用线程收回执行，不会发生死锁
+ * 4. 结果按索引写入由调用方负责，因此输出顺序与串行计算完全一致
+ */
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
+
+class ParallelFor
+{
+public:
+    // 并行执行 body(i), i = 0 .. count-1
+    // cancel 不为空且被置位后，尚未领取的索引不再执行
+    static void run(int count, const std::function<void(int)>& body,
+                    const std::atomic<bool>* cancel = nullptr);
+
+    // 模型计算专用线程池
+    static QThreadPool* pool();
+};
+
+#endif // PARALLELFOR_H
@@ -5,15 +5,29 @@
  * 1. 实现了对话框的初始化，设置默认的图例名称为 "Pressure" 而非 "Delta P"。
  * 2. 实现了颜色选择器的调用逻辑。
  * 3. 提供了从UI控件获取配置参数的具体实现。
+ * 4. L-Spacing 预览：数据或平滑设置变化时调用 PressureDerivativeCalculator::calculateBourdetDerivatives
+ *    一遍算出全部预设 L 的导数并缓存，拖动滑块只替换曲线数据，不再重新计算。
  */
 
 #include "plottingdialog3.h"
 #include "ui_plottingdialog3.h"
+#include "derivativesmoother.h"
+#include "pressurederivativecalculator.h"
 #include <QColorDialog>
+#include <cmath>
 
 // 初始化静态计数器
 int PlottingDialog3::s_counter = 1;
 
+// 预览的 L-Spacing 预设值: 0.05, 0.10, ..., 0.50
+static const double L_PRESET_STEP = 0.05;
+static const int L_PRESET_COUNT = 10;
+
+static double presetLSpacing(int index)
+{
+    return L_PRESET_STEP * (index + 1);
+}
+
 // 构造函数实现
 PlottingDialog3::PlottingDialog3(QStandardItemModel* model, QWidget *parent) :
     QDialog(parent),
@@ -22,7 +36,8 @@ PlottingDialog3::PlottingDialog3(QStandardItemModel* model, QWidget *parent) :
     m_pressPointColor(Qt::red),    // 默认压力点颜色：红
     m_pressLineColor(Qt::red),     // 默认压力线颜色：红
     m_derivPointColor(Qt::blue),   // 默认导数点颜色：蓝
-    m_derivLineColor(Qt::blue)     // 默认导数线颜色：蓝
+    m_derivLineColor(Qt::blue),    // 默认导数线颜色：蓝
+    m_previewPlot(nullptr)
 {
     ui->setupUi(this);
 
@@ -40,6 +55,9 @@ PlottingDialog3::PlottingDialog3(QStandardItemModel* model, QWidget *parent) :
     populateComboBoxes();
     // 初始化样式选项
     setupStyleOptions();
+    ui->comboSmoothMethod->addItems(DerivativeSmoother::methodNames());
+    // 初始化 L-Spacing 预览
+    setupPreviewPlot();
 
     // 连接信号与槽
     // 当平滑复选框切换时，启用或禁用平滑因子输入框
@@ -51,6 +69,18 @@ PlottingDialog3::PlottingDialog3(QStandardItemModel* model, QWidget *parent) :
     connect(ui->btnPressLineColor, &QPushButton::clicked, this, &PlottingDialog3::selectPressLineColor);
     connect(ui->btnDerivPointColor, &QPushButton::clicked, this, &PlottingDialog3::selectDerivPointColor);
     connect(ui->btnDerivLineColor, &QPushButton::clicked, this, &PlottingDialog3::selectDerivLineColor);
+
+    // L-Spacing 预览：影响导数数据的设置变化时重算，滑块与输入框只切换曲线
+    connect(ui->sliderL, &QSlider::valueChanged, this, &PlottingDialog3::onLSliderChanged);
+    connect(ui->spinL, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &PlottingDialog3::onLSpinChanged);
+    connect(ui->comboTime, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PlottingDialog3::updatePreview);
+    connect(ui->comboPress, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PlottingDialog3::updatePreview);
+    connect(ui->radioMeasured, &QRadioButton::toggled, this, &PlottingDialog3::updatePreview);
+    connect(ui->checkSmooth, &QCheckBox::toggled, this, &PlottingDialog3::updatePreview);
+    connect(ui->spinSmooth, QOverload<int>::of(&QSpinBox::valueChanged), this, &PlottingDialog3::updatePreview);
+    connect(ui->comboSmoothMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PlottingDialog3::updatePreview);
+    onLSpinChanged(ui->spinL->value());
+    updatePreview();
 }
 
 // 析构函数实现
@@ -114,6 +144,126 @@ void PlottingDialog3::setupStyleOptions()
 void PlottingDialog3::onSmoothToggled(bool checked)
 {
     ui->spinSmooth->setEnabled(checked);
+    ui->comboSmoothMethod->setEnabled(checked);
+}
+
+// 初始化预览图：双对数坐标，压降与导数两条曲线
+void PlottingDialog3::setupPreviewPlot()
+{
+    m_previewPlot = new QCustomPlot(this);
+    m_previewPlot->setMinimumHeight(220);
+    ui->layoutPreview->addWidget(m_previewPlot);
+
+    QSharedPointer<QCPAxisTickerLog> logTicker(new QCPAxisTickerLog);
+    m_previewPlot->xAxis->setScaleType(QCPAxis::stLogarithmic);
+    m_previewPlot->xAxis->setTicker(logTicker);
+    m_previewPlot->yAxis->setScaleType(QCPAxis::stLogarithmic);
+    m_previewPlot->yAxis->setTicker(logTicker);
+    m_previewPlot->xAxis->setNumberFormat("eb"); m_previewPlot->xAxis->setNumberPrecision(0);
+    m_previewPlot->yAxis->setNumberFormat("eb"); m_previewPlot->yAxis->setNumberPrecision(0);
+
+    QCPGraph* pressGraph = m_previewPlot->addGraph();
+    pressGraph->setLineStyle(QCPGraph::lsNone);
+    pressGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, m_pressPointColor, 3));
+
+    QCPGraph* derivGraph = m_previewPlot->addGraph();
+    derivGraph->setLineStyle(QCPGraph::lsNone);
+    derivGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssTriangle, m_derivPointColor, 4));
+
+    ui->sliderL->setRange(0, L_PRESET_COUNT - 1);
+}
+
+// 读取数据并一次算出全部预设 L 的导数
+void PlottingDialog3::updatePreview()
+{
+    m_previewT.clear();
+    m_previewP.clear();
+    m_previewDerivs.clear();
+
+    int tCol = ui->comboTime->currentIndex();
+    int pCol = ui->comboPress->currentIndex();
+    if (m_dataModel && tCol >= 0 && pCol >= 0) {
+        // 与 WT_PlottingWidget 生成导数曲线时的取点规则一致
+        bool isMeasured = ui->radioMeasured->isChecked();
+        double initialP = 0; bool first = true;
+        for (int i = 0; i < m_dataModel->rowCount(); ++i) {
+            QStandardItem* tItem = m_dataModel->item(i, tCol);
+            QStandardItem* pItem = m_dataModel->item(i, pCol);
+            if (!tItem || !pItem) continue;
+            double t = tItem->text().toDouble();
+            double p = pItem->text().toDouble();
+            if (first) { initialP = p; first = false; }
+            double dp = isMeasured ? std::abs(p - initialP) : p;
+            if (t > 0 && dp > 0) { m_previewT.append(t); m_previewP.append(dp); }
+        }
+    }
+
+    double yMin = 0, yMax = 0;
+    if (m_previewT.size() >= 3) {
+        QVector<double> lSpacings;
+        for (int k = 0; k < L_PRESET_COUNT; ++k) lSpacings.append(presetLSpacing(k));
+        m_previewDerivs = PressureDerivativeCalculator::calculateBourdetDerivatives(m_previewT, m_previewP, lSpacings);
+
+        if (isSmoothEnabled() && getSmoothFactor() > 1) {
+            DerivativeSmoother::Method method = (DerivativeSmoother::Method)getSmoothMethod();
+            for (QVector<double>& d : m_previewDerivs) {
+                d = DerivativeSmoother::smooth(m_previewT, d, method, getSmoothFactor());
+            }
+        }
+
+        // 纵轴范围覆盖全部预设 L 的曲线，切换时坐标轴保持不动便于比较
+        auto extend = [&](const QVector<double>& v) {
+            for (double y : v) {
+                if (!(y > 0) || !std::isfinite(y)) continue;
+                if (yMax <= 0) { yMin = yMax = y; continue; }
+                yMin = qMin(yMin, y);
+                yMax = qMax(yMax, y);
+            }
+        };
+        extend(m_previewP);
+        for (const QVector<double>& d : m_previewDerivs) extend(d);
+    }
+
+    m_previewPlot->graph(0)->setData(m_previewT, m_previewP);
+    if (yMax > 0) {
+        m_previewPlot->xAxis->rescale();
+        m_previewPlot->yAxis->setRange(yMin / 2, yMax * 2);
+    }
+    showPreviewCurve(ui->sliderL->value());
+}
+
+// 显示第 index 个预设 L 的导数曲线
+void PlottingDialog3::showPreviewCurve(int index)
+{
+    if (!m_previewPlot) return;
+    if (index >= 0 && index < m_previewDerivs.size()) {
+        m_previewPlot->graph(1)->setData(m_previewT, m_previewDerivs[index]);
+    } else {
+        m_previewPlot->graph(1)->data()->clear();
+    }
+    m_previewPlot->replot();
+}
+
+// 滑块切换 L：同步输入框，曲线直接取缓存
+void PlottingDialog3::onLSliderChanged(int index)
+{
+    double lSpacing = presetLSpacing(index);
+    ui->labelLValue->setText(QString::number(lSpacing, 'f', 2));
+    ui->spinL->blockSignals(true);
+    ui->spinL->setValue(lSpacing);
+    ui->spinL->blockSignals(false);
+    showPreviewCurve(index);
+}
+
+// 手动输入 L：滑块跟随到最接近的预设值
+void PlottingDialog3::onLSpinChanged(double value)
+{
+    int index = qBound(0, qRound(value / L_PRESET_STEP) - 1, L_PRESET_COUNT - 1);
+    ui->labelLValue->setText(QString::number(presetLSpacing(index), 'f', 2));
+    ui->sliderL->blockSignals(true);
+    ui->sliderL->setValue(index);
+    ui->sliderL->blockSignals(false);
+    showPreviewCurve(index);
 }
 
 // 更新颜色按钮样式表
@@ -149,6 +299,7 @@ bool PlottingDialog3::isMeasuredPressure() const { return ui->radioMeasured->isC
 double PlottingDialog3::getLSpacing() const { return ui->spinL->value(); }
 bool PlottingDialog3::isSmoothEnabled() const { return ui->checkSmooth->isChecked(); }
 int PlottingDialog3::getSmoothFactor() const { return ui->spinSmooth->value(); }
+int PlottingDialog3::getSmoothMethod() const { return ui->comboSmoothMethod->currentIndex(); }
 QString PlottingDialog3::getXLabel() const { return ui->lineXLabel->text(); }
 QString PlottingDialog3::getYLabel() const { return ui->lineYLabel->text(); }
 
@@ -5,6 +5,7 @@
  * 1. 声明了用于配置曲线样式的对话框类。
  * 2. 提供获取用户设置（如曲线名称、图例、数据列索引、样式颜色等）的接口。
  * 3. 管理界面交互逻辑，如颜色选择、平滑参数的启用状态等。
+ * 4. L-Spacing 预览：一次算出全部预设 L 的导数，拖动滑块即时切换曲线。
  */
 
 #ifndef PLOTTINGDIALOG3_H
@@ -43,6 +44,7 @@ public:
     double getLSpacing() const;         // 获取导数计算步长 L-Spacing
     bool isSmoothEnabled() const;       // 获取是否启用平滑处理
     int getSmoothFactor() const;        // 获取平滑因子
+    int getSmoothMethod() const;        // 获取平滑方法 (DerivativeSmoother::Method)
 
     // --- 坐标轴标签接口 ---
     QString getXLabel() const;          // 获取X轴标签文本
@@ -67,6 +69,13 @@ private slots:
     // 槽函数：响应“启用平滑”复选框的状态变化
     void onSmoothToggled(bool checked);
 
+    // 槽函数：数据列、压力类型或平滑设置变化时，重新计算全部预设 L 的导数
+    void updatePreview();
+    // 槽函数：滑块切换 L，只显示已算好的曲线
+    void onLSliderChanged(int index);
+    // 槽函数：手动输入 L 时，滑块跟随到最接近的预设值
+    void onLSpinChanged(double value);
+
     // 槽函数：响应各颜色选择按钮的点击事件
     void selectPressPointColor();
     void selectPressLineColor();
@@ -84,12 +93,22 @@ private:
     QColor m_derivPointColor;
     QColor m_derivLineColor;
 
+    // L-Spacing 预览
+    QCustomPlot* m_previewPlot;
+    QVector<double> m_previewT;                 // 有效点的时间
+    QVector<double> m_previewP;                 // 有效点的压降
+    QVector<QVector<double>> m_previewDerivs;   // 各预设 L 对应的导数 (已按设置平滑)
+
     // 私有辅助函数：填充下列列表框（ComboBox）
     void populateComboBoxes();
     // 私有辅助函数：初始化样式选项（点形、线型等）
     void setupStyleOptions();
     // 私有辅助函数：更新颜色按钮的背景显示
     void updateColorButton(QPushButton* btn, const QColor& color);
+    // 私有辅助函数：初始化预览图的坐标轴与曲线
+    void setupPreviewPlot();
+    // 私有辅助函数：显示第 index 个预设 L 的导数曲线
+    void showPreviewCurve(int index);
 };
 
 #endif // PLOTTINGDIALOG3_H
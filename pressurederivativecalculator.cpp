@@ -2,7 +2,24 @@
 #include <QStandardItem>
 #include <QRegularExpression>
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+
+namespace {
+
+// ln t 是否递增 (t <= 0 的 NaN 点只出现在开头)；first 返回第一个有效点
+bool isLogTimeSorted(const double* x, int n, int& first)
+{
+    first = 0;
+    while (first < n && std::isnan(x[first])) ++first;
+    for (int i = first + 1; i < n; ++i) {
+        if (!(x[i] >= x[i - 1])) return false;
+    }
+    return true;
+}
+
+} // namespace
 
 PressureDerivativeCalculator::PressureDerivativeCalculator(QObject *parent)
     : QObject(parent)
@@ -176,141 +193,180 @@ PressureDerivativeResult PressureDerivativeCalculator::calculatePressureDerivati
 }
 
 // 静态方法实现：Bourdet 导数核心算法 (Saphir 方法)
+// 说明：ln t 只计算一次存入连续数组；时间递增时左右窗口端点用双指针线性扫描，总计算量 O(n)；
+//       加权斜率公式以无分支循环计算，窗口不完整的首尾点再逐点改写
 QVector<double> PressureDerivativeCalculator::calculateBourdetDerivative(
     const QVector<double>& timeData,
     const QVector<double>& pressureDropData,
     double lSpacing)
 {
-    QVector<double> derivativeData;
     int n = timeData.size();
-    derivativeData.reserve(n);
-
+    QVector<double> derivativeData(n, 0.0);
     if (n == 0) return derivativeData;
 
-    for (int i = 0; i < n; ++i) {
-        double derivative = 0.0;
-        double ti = timeData[i];
-        double pi = pressureDropData[i];
-
-        // 寻找左侧点j：ln(ti) - ln(tj) ≥ L
-        int leftIndex = findLeftPoint(timeData, i, lSpacing);
-
-        // 寻找右侧点k：ln(tk) - ln(ti) ≥ L
-        int rightIndex = findRightPoint(timeData, i, lSpacing);
-
-        // 1. 如果找到左右两个点，使用加权平均法 (Bourdet Standard)
-        if (leftIndex >= 0 && rightIndex >= 0) {
-            double tj = timeData[leftIndex];
-            double pj = pressureDropData[leftIndex];
-            double tk = timeData[rightIndex];
-            double pk = pressureDropData[rightIndex];
-
-            // 计算对数差值
-            double deltaXL = std::log(ti) - std::log(tj);  // ΔXL = ln(ti) - ln(tj)
-            double deltaXR = std::log(tk) - std::log(ti);  // ΔXR = ln(tk) - ln(ti)
-
-            // 计算左导数和右导数
-            double mL = calculateDerivativeValue(ti, tj, pi, pj);  // 左导数 slope
-            double mR = calculateDerivativeValue(tk, ti, pk, pi);  // 右导数 slope
-
-            // 加权平均公式：P' = (mL * ΔXR + mR * ΔXL) / (ΔXL + ΔXR)
-            if (deltaXL + deltaXR > 1e-12) {
-                derivative = (mL * deltaXR + mR * deltaXL) / (deltaXL + deltaXR);
-            } else {
-                derivative = 0.0;
-            }
-        }
-        // 2. 边界情况：只找到左侧点 (曲线末端)
-        else if (leftIndex >= 0 && rightIndex < 0) {
-            double tj = timeData[leftIndex];
-            double pj = pressureDropData[leftIndex];
-            derivative = calculateDerivativeValue(ti, tj, pi, pj);
-        }
-        // 3. 边界情况：只找到右侧点 (曲线开端)
-        else if (leftIndex < 0 && rightIndex >= 0) {
-            double tk = timeData[rightIndex];
-            double pk = pressureDropData[rightIndex];
-            derivative = calculateDerivativeValue(tk, ti, pk, pi);
-        }
-        // 4. L-Spacing 范围内点不足 (通常是数据极少或 L 设置过大)
-        else {
-            // 使用简单的相邻点差分作为保底
-            if (i > 0) {
-                double t_prev = timeData[i-1];
-                double p_prev = pressureDropData[i-1];
-                derivative = calculateDerivativeValue(ti, t_prev, pi, p_prev);
-            } else if (i < n - 1) {
-                double t_next = timeData[i+1];
-                double p_next = pressureDropData[i+1];
-                derivative = calculateDerivativeValue(t_next, ti, p_next, pi);
-            } else {
-                derivative = 0.0;
-            }
-        }
+    // 1. ln t (t <= 0 的点记为 NaN，任何比较均不成立，因而不会被选为窗口端点)
+    QVector<double> lnT = logTime(timeData);
 
-        derivativeData.append(derivative);
-    }
+    // 2. 左侧点j：ln(ti) - ln(tj) ≥ L 的最近点；右侧点k：ln(tk) - ln(ti) ≥ L 的最近点
+    QVector<int> left, right;
+    findWindowPoints(lnT, lSpacing, left, right);
 
+    // 3. 加权斜率
+    evaluateBourdetDerivative(timeData.constData(), lnT.constData(), pressureDropData.constData(),
+                              left.constData(), right.constData(), n, 0, n, derivativeData.data());
     return derivativeData;
 }
 
-int PressureDerivativeCalculator::findLeftPoint(const QVector<double>& timeData, int currentIndex, double lSpacing)
+QVector<QVector<double>> PressureDerivativeCalculator::calculateBourdetDerivatives(
+    const QVector<double>& timeData,
+    const QVector<double>& pressureDropData,
+    const QVector<double>& lSpacings)
 {
-    if (currentIndex <= 0 || timeData.isEmpty()) return -1;
-
-    double ti = timeData[currentIndex];
-    if (ti <= 0) return -1;
-    double lnTi = std::log(ti);
-
-    // 从当前点向左搜索，找到第一个满足距离 >= L 的点
-    for (int j = currentIndex - 1; j >= 0; --j) {
-        double tj = timeData[j];
-        if (tj <= 0) continue;
-
-        double lnTj = std::log(tj);
-        if ((lnTi - lnTj) >= lSpacing) {
-            return j;
-        }
+    int n = timeData.size();
+    int count = lSpacings.size();
+    QVector<QVector<double>> derivatives(count, QVector<double>(n, 0.0));
+    if (n == 0 || count == 0) return derivatives;
+
+    // ln t 只算一次，所有 L 的窗口端点在同一遍扫描中推进
+    QVector<double> lnT = logTime(timeData);
+    QVector<QVector<int>> left, right;
+    findWindowPoints(lnT, lSpacings, left, right);
+
+    for (int k = 0; k < count; ++k) {
+        evaluateBourdetDerivative(timeData.constData(), lnT.constData(), pressureDropData.constData(),
+                                  left[k].constData(), right[k].constData(), n, 0, n, derivatives[k].data());
     }
-    return -1;
+    return derivatives;
 }
 
-int PressureDerivativeCalculator::findRightPoint(const QVector<double>& timeData, int currentIndex, double lSpacing)
+QVector<double> PressureDerivativeCalculator::logTime(const QVector<double>& timeData)
 {
     int n = timeData.size();
-    if (currentIndex >= n - 1 || timeData.isEmpty()) return -1;
+    QVector<double> lnT(n);
+    const double* t = timeData.constData();
+    double* x = lnT.data();
+    for (int i = 0; i < n; ++i) {
+        x[i] = (t[i] > 0) ? std::log(t[i]) : std::numeric_limits<double>::quiet_NaN();
+    }
+    return lnT;
+}
 
-    double ti = timeData[currentIndex];
-    if (ti <= 0) return -1;
-    double lnTi = std::log(ti);
+void PressureDerivativeCalculator::evaluateBourdetDerivative(const double* t, const double* x, const double* p,
+                                                             const int* lo, const int* hi, int n, int from, int to, double* d)
+{
+    // 1. 左右点都存在时使用加权平均法 (Bourdet Standard)
+    //    循环内无分支 (只有条件选择)；端点缺失的位置暂以自身代替，结果在第 2 步改写
+    for (int i = from; i < to; ++i) {
+        int j = lo[i] >= 0 ? lo[i] : i;
+        int k = hi[i] >= 0 ? hi[i] : i;
+        double deltaXL = x[i] - x[j];  // ΔXL = ln(ti) - ln(tj)
+        double deltaXR = x[k] - x[i];  // ΔXR = ln(tk) - ln(ti)
+        bool flatL = std::abs(deltaXL) < 1e-10;
+        bool flatR = std::abs(deltaXR) < 1e-10;
+        double mL = flatL ? 0.0 : (p[i] - p[j]) / (flatL ? 1.0 : deltaXL);  // 左导数 slope
+        double mR = flatR ? 0.0 : (p[k] - p[i]) / (flatR ? 1.0 : deltaXR);  // 右导数 slope
+        // 加权平均公式：P' = (mL * ΔXR + mR * ΔXL) / (ΔXL + ΔXR)
+        double w = deltaXL + deltaXR;
+        d[i] = (w > 1e-12) ? (mL * deltaXR + mR * deltaXL) / (w > 1e-12 ? w : 1.0) : 0.0;
+    }
 
-    // 从当前点向右搜索，找到第一个满足距离 >= L 的点
-    for (int k = currentIndex + 1; k < n; ++k) {
-        double tk = timeData[k];
-        if (tk <= 0) continue;
+    // 2. 窗口不完整的点 (曲线首尾、t <= 0 的点) 逐点处理
+    auto slope = [&](int a, int b) {
+        // 单边导数：dP/d(ln t) = (pa - pb) / (ln(ta) - ln(tb))
+        if (t[a] <= 0 || t[b] <= 0) return 0.0;
+        double deltaLnT = x[a] - x[b];
+        return (std::abs(deltaLnT) < 1e-10) ? 0.0 : (p[a] - p[b]) / deltaLnT;
+    };
+    for (int i = from; i < to; ++i) {
+        if (lo[i] >= 0 && hi[i] >= 0) continue;
+        if (lo[i] >= 0) d[i] = slope(i, lo[i]);          // 只找到左侧点 (曲线末端)
+        else if (hi[i] >= 0) d[i] = slope(hi[i], i);     // 只找到右侧点 (曲线开端)
+        else if (i > 0) d[i] = slope(i, i - 1);          // L-Spacing 范围内点不足，使用相邻点差分作为保底
+        else if (i < n - 1) d[i] = slope(i + 1, i);
+        else d[i] = 0.0;
+    }
+}
 
-        double lnTk = std::log(tk);
-        if ((lnTk - lnTi) >= lSpacing) {
-            return k;
+void PressureDerivativeCalculator::findWindowPoints(const QVector<double>& lnT, double lSpacing,
+                                                    QVector<int>& left, QVector<int>& right)
+{
+    int n = lnT.size();
+    const double* x = lnT.constData();
+    left.fill(-1, n);
+    right.fill(-1, n);
+
+    // 时间递增 (t <= 0 的点只出现在开头) 时两个端点都随 i 单调右移，双指针一遍扫描
+    int first = 0;
+    if (isLogTimeSorted(x, n, first)) {
+        int l = first - 1;
+        int r = first;
+        for (int i = first; i < n; ++i) {
+            while (l + 1 < i && (x[i] - x[l + 1]) >= lSpacing) ++l;
+            if (l >= first) left[i] = l;
+            if (r <= i) r = i + 1;
+            while (r < n && !((x[r] - x[i]) >= lSpacing)) ++r;
+            if (r < n) right[i] = r;
+        }
+        return;
+    }
+
+    // 时间无序时逐点向两侧搜索
+    for (int i = 0; i < n; ++i) {
+        for (int j = i - 1; j >= 0; --j) {
+            if ((x[i] - x[j]) >= lSpacing) { left[i] = j; break; }
+        }
+        for (int k = i + 1; k < n; ++k) {
+            if ((x[k] - x[i]) >= lSpacing) { right[i] = k; break; }
         }
     }
-    return -1;
 }
 
-double PressureDerivativeCalculator::calculateDerivativeValue(double t1, double t2, double p1, double p2)
+void PressureDerivativeCalculator::findWindowPoints(const QVector<double>& lnT, const QVector<double>& lSpacings,
+                                                    QVector<QVector<int>>& left, QVector<QVector<int>>& right)
 {
-    // 计算单边导数：dP/d(ln t) = (p1 - p2) / (ln(t1) - ln(t2))
-    if (t1 <= 0 || t2 <= 0) return 0.0;
-
-    double lnT1 = std::log(t1);
-    double lnT2 = std::log(t2);
-    double deltaLnT = lnT1 - lnT2;
+    int n = lnT.size();
+    int count = lSpacings.size();
+    const double* x = lnT.constData();
+    left.resize(count);
+    right.resize(count);
+
+    int first = 0;
+    if (!isLogTimeSorted(x, n, first)) {
+        for (int k = 0; k < count; ++k) findWindowPoints(lnT, lSpacings[k], left[k], right[k]);
+        return;
+    }
 
-    if (std::abs(deltaLnT) < 1e-10) {
-        return 0.0;
+    // 按 L 从小到大处理: L 越大右端点越靠右，可从上一个 L 的右端点直接起步
+    QVector<int> order(count);
+    for (int k = 0; k < count; ++k) order[k] = k;
+    std::sort(order.begin(), order.end(), [&lSpacings](int a, int b) { return lSpacings[a] < lSpacings[b]; });
+
+    QVector<int*> lo(count), hi(count);
+    for (int k = 0; k < count; ++k) {
+        left[k].fill(-1, n);
+        right[k].fill(-1, n);
+        lo[k] = left[k].data();
+        hi[k] = right[k].data();
     }
 
-    return (p1 - p2) / deltaLnT;
+    QVector<int> l(count, first - 1);
+    QVector<int> r(count, first);
+    for (int i = first; i < n; ++i) {
+        int shared = i + 1;
+        for (int k : order) {
+            double lSpacing = lSpacings[k];
+            int a = l[k];
+            while (a + 1 < i && (x[i] - x[a + 1]) >= lSpacing) ++a;
+            l[k] = a;
+            if (a >= first) lo[k][i] = a;
+
+            int b = std::max(r[k], shared);
+            while (b < n && !((x[b] - x[i]) >= lSpacing)) ++b;
+            r[k] = b;
+            shared = b;
+            if (b < n) hi[k][i] = b;
+        }
+    }
 }
 
 PressureDerivativeConfig PressureDerivativeCalculator::autoDetectColumns(QStandardItemModel* model)
@@ -46,7 +46,8 @@ struct PressureDerivativeConfig {
  * 使用Bourdet导数算法（L-Spacing平滑算法）计算压力导数：
  * P' = dP/d(ln t) = t * dP/dt
  *
- * 核心算法已提取为静态方法，供 FittingWidget, ModelManager 等模块复用。
+ * 核心算法已提取为静态方法，供 FittingWidget, ModelManager, WT_PlottingWidget 等模块复用。
+ * ln t 只计算一次，时间递增时窗口端点双指针扫描，计算量与点数成线性关系。
  */
 class PressureDerivativeCalculator : public QObject
 {
@@ -87,16 +88,39 @@ public:
                                                       const QVector<double>& pressureDropData,
                                                       double lSpacing);
 
+    /**
+     * @brief 一次计算多个 L-Spacing 下的导数 (用于交互选择 L)
+     * @param lSpacings L-Spacing 集合 (如 0.05 ~ 0.5)
+     * @return 与 lSpacings 一一对应的导数曲线，每条与 calculateBourdetDerivative 的结果相同
+     */
+    static QVector<QVector<double>> calculateBourdetDerivatives(const QVector<double>& timeData,
+                                                                const QVector<double>& pressureDropData,
+                                                                const QVector<double>& lSpacings);
+
+    // 以下为 Bourdet 导数的分步接口，供增量计算 (IncrementalDerivative) 复用
+
+    // ln t (t <= 0 的点记为 NaN)
+    static QVector<double> logTime(const QVector<double>& timeData);
+
+    // 由 ln t 求各点左右 L-Spacing 窗口端点 (不存在时为 -1)；时间递增时双指针线性扫描
+    static void findWindowPoints(const QVector<double>& lnT, double lSpacing, QVector<int>& left, QVector<int>& right);
+    // 多个 L 的窗口端点，在同一遍扫描中推进
+    static void findWindowPoints(const QVector<double>& lnT, const QVector<double>& lSpacings,
+                                 QVector<QVector<int>>& left, QVector<QVector<int>>& right);
+
+    /**
+     * @brief 由窗口端点计算 [from, to) 区间内各点的导数
+     * @param n 序列总长度 (窗口均不完整时的相邻点差分保底规则与之有关)
+     * @param out 长度为 n 的输出数组，只写入 [from, to)
+     */
+    static void evaluateBourdetDerivative(const double* timeData, const double* lnT, const double* pressureDropData,
+                                          const int* left, const int* right, int n, int from, int to, double* out);
+
 signals:
     void progressUpdated(int progress, const QString& message);
     void calculationCompleted(const PressureDerivativeResult& result);
 
 private:
-    // 内部静态辅助函数
-    static int findLeftPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
-    static int findRightPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
-    static double calculateDerivativeValue(double t1, double t2, double p1, double p2);
-
     int findPressureColumn(QStandardItemModel* model);
     int findTimeColumn(QStandardItemModel* model);
     double parseNumericValue(const QString& str);
@@ -39,6 +39,9 @@ public:
      */
     static QVector<double> smoothData(const QVector<double>& data, int span);
 
+    // 只计算 [from, to) 区间的平滑结果 (写入长度为 data.size() 的 out)，用于增量更新
+    static void smoothRange(const QVector<double>& data, int span, int from, int to, double* out);
+
 signals:
     void progressUpdated(int progress, const QString& message);
     void calculationCompleted(const PressureDerivativeResult& result);
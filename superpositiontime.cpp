@@ -0,0 +1,281 @@
+/*
+ * superpositiontime.cpp
+ * 文件作用：变产量叠加时间与等效时间导数计算实现文件
+ * 功能描述：
+ * 1. 远场展开: 对中心为 c、半径为 r 的一组流动段，当 r ≤ (t − c) / 3 时
+ *    Σ Δq_i · ln(t − t_i) = M_0 · ln(t − c) − Σ_k (r / (t − c))^k · M_k / k，M_k = Σ Δq_i · ((t_i − c) / r)^k
+ * 2. 自根节点向下遍历，满足条件的节点直接用展开式，其余节点展开到叶节点后逐项求和
+ * 3. 各压力点的叠加和用 ParallelFor 分块并行计算
+ * 4. 导数计算复用 PressureDerivativeCalculator::findWindowPoints / evaluateBourdetDerivative
+ */
+
+#include "superpositiontime.h"
+#include "pressurederivativecalculator.h"
+#include "parallelfor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 远场展开的适用条件: 组半径不超过到组中心距离的 1/3
+const double FAR_FIELD_RATIO = 1.0 / 3.0;
+
+} // namespace
+
+SuperpositionTime::SuperpositionTime(const QVector<double>& stepTimes, const QVector<double>& rates)
+{
+    // 1. 产量变化: 产量不变的流动段并入上一段，开始时间不递增的流动段覆盖上一段的产量
+    int m = qMin(stepTimes.size(), rates.size());
+    double prevRate = 0.0;
+    for (int i = 0; i < m; ++i) {
+        double q = rates[i];
+        if (q == prevRate) continue;
+        if (!m_t.isEmpty() && !(stepTimes[i] > m_t.last())) {
+            m_dq.last() += q - prevRate;
+            if (m_dq.last() == 0.0) {
+                m_t.removeLast();
+                m_dq.removeLast();
+            }
+        } else {
+            m_t.append(stepTimes[i]);
+            m_dq.append(q - prevRate);
+        }
+        prevRate = q;
+    }
+
+    // 2. 二叉树与各节点的矩
+    if (!m_t.isEmpty()) build(0, m_t.size() - 1);
+
+    // 3. 各流动段起点的叠加和，用于等效时间
+    m_offset.resize(m_t.size());
+    for (int n = 0; n < m_t.size(); ++n) {
+        m_offset[n] = superpositionSum(m_t[n], n - 1);
+    }
+}
+
+SuperpositionTime SuperpositionTime::fromDurations(const QVector<double>& durations, const QVector<double>& rates)
+{
+    int m = qMin(durations.size(), rates.size());
+    QVector<double> stepTimes(m);
+    double tCum = 0.0;
+    for (int i = 0; i < m; ++i) {
+        stepTimes[i] = tCum;
+        tCum += durations[i];
+    }
+    return SuperpositionTime(stepTimes, rates.mid(0, m));
+}
+
+void SuperpositionTime::compressRateHistory(QVector<double>& stepTimes, QVector<double>& rates, double tolerance)
+{
+    int m = qMin(stepTimes.size(), rates.size());
+    if (m < 3 || tolerance <= 0) return;
+
+    double maxRate = 0.0;
+    for (int i = 0; i < m; ++i) maxRate = qMax(maxRate, std::abs(rates[i]));
+    double limit = tolerance * maxRate;
+
+    QVector<double> outT, outQ;
+    int runStart = 0;
+    double duration = stepTimes[1] - stepTimes[0];
+    double volume = rates[0] * duration;
+    auto average = [&]() { return duration > 0 ? volume / duration : rates[runStart]; };
+
+    // 最后一段没有结束时间，不参与合并
+    for (int i = 1; i < m - 1; ++i) {
+        double dur = stepTimes[i + 1] - stepTimes[i];
+        if (std::abs(rates[i] - average()) <= limit) {
+            volume += rates[i] * dur;
+            duration += dur;
+        } else {
+            outT.append(stepTimes[runStart]);
+            outQ.append(average());
+            runStart = i;
+            duration = dur;
+            volume = rates[i] * dur;
+        }
+    }
+    outT.append(stepTimes[runStart]);
+    outQ.append(average());
+    outT.append(stepTimes[m - 1]);
+    outQ.append(rates[m - 1]);
+
+    stepTimes = outT;
+    rates = outQ;
+}
+
+int SuperpositionTime::build(int first, int last)
+{
+    const int P = EXPANSION_ORDER;
+    int index = m_nodes.size();
+    Node node;
+    node.first = first;
+    node.last = last;
+    node.left = -1;
+    node.right = -1;
+    node.center = 0.5 * (m_t[first] + m_t[last]);
+    node.radius = 0.5 * (m_t[last] - m_t[first]);
+    m_nodes.append(node);
+
+    m_moments.resize(m_nodes.size() * (P + 1));
+    double* moment = m_moments.data() + index * (P + 1);
+    for (int k = 0; k <= P; ++k) moment[k] = 0.0;
+    for (int i = first; i <= last; ++i) {
+        double u = node.radius > 0 ? (m_t[i] - node.center) / node.radius : 0.0;
+        double term = m_dq[i];
+        for (int k = 0; k <= P; ++k) {
+            moment[k] += term;
+            term *= u;
+        }
+    }
+
+    if (last - first + 1 > LEAF_SIZE) {
+        int mid = (first + last) / 2;
+        int left = build(first, mid);
+        int right = build(mid + 1, last);
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+    }
+    return index;
+}
+
+int SuperpositionTime::periodOf(double t) const
+{
+    if (std::isnan(t)) return -1;
+    return int(std::lower_bound(m_t.constBegin(), m_t.constEnd(), t) - m_t.constBegin()) - 1;
+}
+
+double SuperpositionTime::superpositionSum(double t, int lastStep) const
+{
+    if (lastStep < 0 || m_nodes.isEmpty()) return 0.0;
+
+    const int P = EXPANSION_ORDER;
+    double sum = 0.0;
+    int stack[128];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        int index = stack[--top];
+        const Node& node = m_nodes[index];
+        if (node.first > lastStep) continue;
+
+        double d = t - node.center;
+        if (node.last <= lastStep && node.radius <= FAR_FIELD_RATIO * d) {
+            // 远场: 级数展开
+            const double* moment = m_moments.constData() + index * (P + 1);
+            double ratio = node.radius / d;
+            double power = 1.0;
+            double series = 0.0;
+            for (int k = 1; k <= P; ++k) {
+                power *= ratio;
+                series += power * moment[k] / k;
+            }
+            sum += moment[0] * std::log(d) - series;
+        } else if (node.left < 0) {
+            // 近场叶节点: 逐项求和
+            int end = qMin(node.last, lastStep);
+            for (int i = node.first; i <= end; ++i) sum += m_dq[i] * std::log(t - m_t[i]);
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = node.left;
+        }
+    }
+    return sum;
+}
+
+void SuperpositionTime::evaluate(const QVector<double>& t, QVector<int>& period, QVector<double>& sum) const
+{
+    int n = t.size();
+    int m = m_t.size();
+    period.resize(n);
+    sum.resize(n);
+
+    int p = -1;
+    for (int i = 0; i < n; ++i) {
+        double ti = t[i];
+        if (std::isnan(ti)) {
+            p = -1;
+        } else if (i > 0 && ti >= t[i - 1]) {
+            // 时间递增: 流动段指针从上一点的位置继续推进
+            while (p + 1 < m && m_t[p + 1] < ti) ++p;
+        } else {
+            p = periodOf(ti);
+        }
+        period[i] = p;
+    }
+
+    // 各点的叠加和互不相关，分块并行
+    const int block = 1024;
+    int blocks = (n + block - 1) / block;
+    ParallelFor::run(blocks, [&](int b) {
+        int end = qMin(n, (b + 1) * block);
+        for (int i = b * block; i < end; ++i) {
+            int k = period[i];
+            sum[i] = (k >= 0) ? superpositionSum(t[i], k) : std::numeric_limits<double>::quiet_NaN();
+        }
+    });
+}
+
+QVector<double> SuperpositionTime::superpositionTime(const QVector<double>& t) const
+{
+    QVector<int> period;
+    QVector<double> x;
+    evaluate(t, period, x);
+    for (int i = 0; i < x.size(); ++i) {
+        if (period[i] >= 0) x[i] /= m_dq[period[i]];
+    }
+    return x;
+}
+
+QVector<double> SuperpositionTime::logEquivalentTime(const QVector<double>& t) const
+{
+    QVector<int> period;
+    QVector<double> x;
+    evaluate(t, period, x);
+    for (int i = 0; i < x.size(); ++i) {
+        int n = period[i];
+        if (n >= 0) x[i] = (x[i] - m_offset[n]) / m_dq[n];
+    }
+    return x;
+}
+
+QVector<double> SuperpositionTime::equivalentTime(const QVector<double>& t) const
+{
+    QVector<double> te = logEquivalentTime(t);
+    for (double& v : te) v = std::exp(v);
+    return te;
+}
+
+QVector<double> SuperpositionTime::derivative(const QVector<double>& t, const QVector<double>& dp, double lSpacing) const
+{
+    int n = qMin(t.size(), dp.size());
+    QVector<double> result(n, 0.0);
+
+    QVector<int> period;
+    QVector<double> lnTe;
+    evaluate(t.mid(0, n), period, lnTe);
+
+    // 逐个流动段 (连续的同一段的点) 计算，窗口不跨越流动段
+    int start = 0;
+    while (start < n) {
+        int end = start;
+        while (end < n && period[end] == period[start]) ++end;
+        int k = period[start];
+        if (k >= 0) {
+            int count = end - start;
+            QVector<double> x(count), te(count);
+            for (int i = 0; i < count; ++i) {
+                x[i] = (lnTe[start + i] - m_offset[k]) / m_dq[k];
+                te[i] = std::exp(x[i]);
+            }
+            QVector<int> left, right;
+            PressureDerivativeCalculator::findWindowPoints(x, lSpacing, left, right);
+            PressureDerivativeCalculator::evaluateBourdetDerivative(te.constData(), x.constData(), dp.constData() + start,
+                                                                   left.constData(), right.constData(),
+                                                                   count, 0, count, result.data() + start);
+        }
+        start = end;
+    }
+    return result;
+}
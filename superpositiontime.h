@@ -0,0 +1,87 @@
+/*
+ * superpositiontime.h
+ * 文件作用：变产量叠加时间与等效时间导数计算头文件
+ * 功能描述：
+ * 1. 由产量历史 (各流动段开始时间与产量) 计算叠加和 S(t) = Σ Δq_i · ln(t − t_i)，Δq_i = q_i − q_{i−1}
+ * 2. 叠加时间函数 X(t) = S(t) / Δq_n 与等效时间 ln te = (S(t) − S(t_n)) / Δq_n (n 为 t 所在流动段)，
+ *    单一产量压降时 te 即为 Δt，一次关井恢复时即为 Agarwal 等效时间 tp·Δt / (tp + Δt)
+ * 3. 以等效时间为横坐标的 Bourdet 导数 dΔp / d ln te，逐流动段复用 PressureDerivativeCalculator 的分步接口
+ * 4. 叠加和按流动段开始时间建立二叉树，远处的一组流动段用关于组中心的级数展开 (预先算好各阶矩) 代替逐项求和，
+ *    每个压力点的计算量为 O(log m · EXPANSION_ORDER)，m 为产量变化次数；
+ *    截断误差不超过 Σ|Δq| · 3^−(EXPANSION_ORDER+1)
+ * 5. 压力点时间递增时所在流动段随之单调推进，各流动段起点的 S(t_n) 在构造时一次算好
+ * 6. 可选的产量历史压缩：合并产量相近的相邻流动段 (按累计产量加权平均)
+ */
+
+#ifndef SUPERPOSITIONTIME_H
+#define SUPERPOSITIONTIME_H
+
+#include <QVector>
+
+class SuperpositionTime
+{
+public:
+    /**
+     * @param stepTimes 各流动段的开始时间 (递增)
+     * @param rates 各流动段的产量；与上一段产量相同的流动段并入上一段
+     */
+    SuperpositionTime(const QVector<double>& stepTimes, const QVector<double>& rates);
+
+    // 由各段持续时间构造 (WT_PlottingWidget 阶梯产量图的数据格式)，第一段从 t = 0 开始
+    static SuperpositionTime fromDurations(const QVector<double>& durations, const QVector<double>& rates);
+
+    /**
+     * @brief 产量历史压缩：相邻流动段产量与当前合并段的平均产量之差不超过 tolerance × 最大产量时合并，
+     *        合并段产量取累计产量除以总时长；最后一个流动段 (通常为分析段) 不参与合并
+     */
+    static void compressRateHistory(QVector<double>& stepTimes, QVector<double>& rates, double tolerance);
+
+    int stepCount() const { return m_t.size(); }
+    double stepTime(int i) const { return m_t[i]; }
+    double rateChange(int i) const { return m_dq[i]; }
+
+    // t 所在的流动段 (t 不晚于第一段开始时为 -1)
+    int periodOf(double t) const;
+
+    // Σ_{i ≤ lastStep} Δq_i · ln(t − t_i)，要求 t 晚于这些流动段的开始时间
+    double superpositionSum(double t, int lastStep) const;
+
+    // 叠加时间函数 X(t) (t 不在任何流动段内时为 NaN)
+    QVector<double> superpositionTime(const QVector<double>& t) const;
+    // 等效时间的对数 ln te 与等效时间 te (NaN 同上)
+    QVector<double> logEquivalentTime(const QVector<double>& t) const;
+    QVector<double> equivalentTime(const QVector<double>& t) const;
+
+    /**
+     * @brief 以等效时间为横坐标的 Bourdet 导数 dΔp / d ln te
+     * @param t 压力点时间 (与产量历史同一时间基准)
+     * @param dp 压降
+     * @param lSpacing L-Spacing (按 ln te 计)
+     * @return 导数；窗口不跨越流动段，不在任何流动段内的点为 0
+     */
+    QVector<double> derivative(const QVector<double>& t, const QVector<double>& dp, double lSpacing) const;
+
+    static const int EXPANSION_ORDER = 16;   // 级数展开阶数
+    static const int LEAF_SIZE = 8;          // 叶节点的流动段数 (叶节点逐项求和)
+
+private:
+    struct Node {
+        int first, last;      // 流动段范围 [first, last]
+        int left, right;      // 子节点 (叶节点为 -1)
+        double center;        // 组中心 (开始时间的中点)
+        double radius;        // 组半径
+    };
+
+    int build(int first, int last);
+    // 求各点所在流动段与 S(t)；sorted 时流动段指针单调推进，否则二分查找
+    void evaluate(const QVector<double>& t, QVector<int>& period, QVector<double>& sum) const;
+
+private:
+    QVector<double> m_t;          // 流动段开始时间
+    QVector<double> m_dq;         // 产量变化 Δq_i
+    QVector<double> m_offset;     // S(t_n) = Σ_{i < n} Δq_i · ln(t_n − t_i)
+    QVector<Node> m_nodes;
+    QVector<double> m_moments;    // 各节点的矩 Σ Δq_i · ((t_i − c) / r)^k，k = 0..EXPANSION_ORDER
+};
+
+#endif // SUPERPOSITIONTIME_H
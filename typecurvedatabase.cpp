@@ -0,0 +1,674 @@
+/*
+ * typecurvedatabase.cpp
+ * 文件作用：无量纲样板曲线库实现文件
+ * 功能描述：
+ * 1. 文件头、轴记录为定长结构，按字节拷贝读写；曲线数据区 8 字节对齐，映射后直接按 float 数组访问
+ * 2. 打开时先校验长度与 CRC32，再解析各轴，任何不一致都拒绝使用该文件
+ * 3. 查询时只对多节点轴插值: k 个多节点轴共 2^k 个角点，每个角点的曲线在 log10 tD 上线性插值后加权求和
+ *    (对数轴在 log10 pD 空间加权，线性轴在 pD 空间加权)
+ * 4. 生成时先在内存中组装完整文件，再经 QSaveFile 一次写出，中途失败或取消不会留下残缺文件
+ * 5. 留出验证与查询使用相同的插值规则 (对数轴在 log10 空间、线性轴在 pD 空间取两节点的平均)，
+ *    误差取全部时间点上 log10 pD 与 log10 导数偏差的最大值；只验证单个轴方向，多个轴同时插值时误差近似叠加
+ */
+
+#include "typecurvedatabase.h"
+#include "parallelfor.h"
+
+#include <QDir>
+#include <QPair>
+#include <QSaveFile>
+#include <QDebug>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+const char MAGIC[8] = { 'W', 'T', 'T', 'Y', 'P', 'E', 'C', 'V' };
+const int NAME_LENGTH = 16;
+const double NODE_TOLERANCE = 1e-9;
+
+struct FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 modelType;
+    quint32 axisCount;
+    quint32 timeCount;
+    quint64 nodeCount;
+    quint64 dataOffset;     // 曲线数据起始位置 (8 字节对齐)
+    quint64 payloadSize;    // CRC32 之前的字节数
+    double tDMin;
+    double tDMax;
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout changed");
+
+struct AxisRecord {
+    char name[NAME_LENGTH];
+    quint32 scale;
+    quint32 nodeCount;
+};
+static_assert(sizeof(AxisRecord) == 24, "AxisRecord layout changed");
+
+// CRC32 (IEEE 802.3，多项式 0xEDB88320) 查找表在编译期生成
+constexpr std::array<quint32, 256> makeCrcTable()
+{
+    std::array<quint32, 256> table{};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr auto CRC_TABLE = makeCrcTable();
+
+bool sameNode(double x, double node)
+{
+    return std::abs(x - node) <= NODE_TOLERANCE * std::max(1.0, std::abs(node));
+}
+
+double axisCoordinate(TypeCurveDatabase::AxisScale scale, double x)
+{
+    return (scale == TypeCurveDatabase::LogScale) ? std::log10(x) : x;
+}
+
+// 第 j-1、j 个时间点之间 log10 pD 的双对数斜率是否在 [0, 1] 内 (压降单调增加且增长不快于线性)；
+// 超出此范围的是极早期反演失真的点，曲线本身不可信，不参与留出验证
+bool physicalSegment(const float* logPD, int j, double spacing)
+{
+    double slope = ((double)logPD[j] - (double)logPD[j - 1]) / spacing;
+    return slope >= -0.01 && slope <= 1.05; // NaN 时为 false
+}
+
+} // namespace
+
+TypeCurveDatabase::TypeCurveDatabase()
+    : m_data(nullptr)
+    , m_type(ModelSolver01_06::Model_1)
+    , m_timeCount(0)
+    , m_tDMin(0.0)
+    , m_tDMax(0.0)
+    , m_dataOffset(0)
+{
+}
+
+TypeCurveDatabase::~TypeCurveDatabase()
+{
+    close();
+}
+
+quint32 TypeCurveDatabase::crc32(const uchar* data, qint64 size)
+{
+    quint32 c = 0xFFFFFFFFu;
+    for (qint64 i = 0; i < size; ++i) c = CRC_TABLE[(c ^ data[i]) & 0xFFu] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+QStringList TypeCurveDatabase::keyParameters()
+{
+    return QStringList{ "M12", "cD", "S", "omega1", "omega2", "lambda1", "rmD", "reD", "LfD", "nf" };
+}
+
+double TypeCurveDatabase::keyValue(const QMap<QString, double>& params, const QString& name)
+{
+    // 默认值与 ModelSolver01_06::buildKernelParams 一致
+    if (name == "M12") {
+        double km = params.value("km", 0.0);
+        return (km > 0.0) ? params.value("kf", 0.0) / km : std::numeric_limits<double>::quiet_NaN();
+    }
+    if (name == "nf") return std::max(1, (int)params.value("nf", 4.0));
+    return params.value(name, 0.0);
+}
+
+bool TypeCurveDatabase::isRelevant(ModelSolver01_06::ModelType type, const QString& name)
+{
+    if (name == "cD" || name == "S") return ModelSolver01_06::hasWellboreStorage(type);
+    if (name == "reD") return !ModelSolver01_06::isInfiniteBoundary(type);
+    return true;
+}
+
+QString TypeCurveDatabase::fileName(ModelSolver01_06::ModelType type)
+{
+    return QString("model%1.wttc").arg((int)type + 1);
+}
+
+const float* TypeCurveDatabase::nodeData(qint64 node) const
+{
+    return reinterpret_cast<const float*>(m_data + m_dataOffset) + node * 2 * m_timeCount;
+}
+
+qint64 TypeCurveDatabase::nodeCount() const
+{
+    return m_axes.isEmpty() ? 0 : m_strides[0] * m_axes[0].nodes.size();
+}
+
+double TypeCurveDatabase::nodeParameter(qint64 node, int axis) const
+{
+    const QVector<double>& nodes = m_axes[axis].nodes;
+    return nodes[(node / m_strides[axis]) % nodes.size()];
+}
+
+// ---------------- 打开与校验 ----------------
+
+bool TypeCurveDatabase::open(const QString& path, QString* error)
+{
+    close();
+    auto fail = [&](const QString& message) {
+        if (error) *error = QString("%1: %2").arg(path, message);
+        close();
+        return false;
+    };
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return fail("无法打开文件");
+    qint64 size = m_file.size();
+    if (size < (qint64)sizeof(FileHeader) + 4) return fail("文件长度不足");
+
+    uchar* map = m_file.map(0, size);
+    if (!map) return fail("内存映射失败");
+    m_data = map;
+
+    FileHeader h;
+    std::memcpy(&h, map, sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) return fail("不是样板曲线库文件");
+    if (h.version != FILE_VERSION) return fail(QString("不支持的版本 %1").arg(h.version));
+    if (h.payloadSize + 4 != (quint64)size) return fail("文件长度与文件头不一致");
+
+    quint32 storedCrc;
+    std::memcpy(&storedCrc, map + h.payloadSize, sizeof(storedCrc));
+    if (crc32(map, (qint64)h.payloadSize) != storedCrc) return fail("CRC32 校验失败");
+
+    if (h.modelType > (quint32)ModelSolver01_06::Model_6) return fail("模型类型无效");
+    if (h.timeCount < 2 || !(h.tDMin > 0.0) || !(h.tDMax > h.tDMin)) return fail("时间网格无效");
+    if (h.dataOffset % 8 != 0) return fail("数据区未对齐");
+
+    // 解析各轴
+    qint64 offset = sizeof(FileHeader);
+    quint64 nodeCount = 1;
+    QVector<Axis> axes;
+    for (quint32 a = 0; a < h.axisCount; ++a) {
+        if (offset + (qint64)sizeof(AxisRecord) > (qint64)h.dataOffset) return fail("轴记录越界");
+        AxisRecord rec;
+        std::memcpy(&rec, map + offset, sizeof(rec));
+        offset += sizeof(rec);
+        if (rec.nodeCount == 0 || rec.scale > DiscreteScale) return fail("轴记录无效");
+        if (offset + (qint64)rec.nodeCount * 8 > (qint64)h.dataOffset) return fail("轴节点越界");
+
+        Axis axis;
+        axis.name = QString::fromLatin1(rec.name, (int)strnlen(rec.name, NAME_LENGTH));
+        axis.scale = (AxisScale)rec.scale;
+        axis.nodes.resize(rec.nodeCount);
+        std::memcpy(axis.nodes.data(), map + offset, rec.nodeCount * sizeof(double));
+        offset += rec.nodeCount * sizeof(double);
+        for (int i = 1; i < axis.nodes.size(); ++i) {
+            if (!(axis.nodes[i] > axis.nodes[i - 1])) return fail("轴节点不是严格递增");
+        }
+        int intervals = (int)rec.nodeCount - 1;
+        if (offset + (qint64)intervals * 8 > (qint64)h.dataOffset) return fail("区间验证误差越界");
+        axis.intervalError.resize(intervals);
+        std::memcpy(axis.intervalError.data(), map + offset, intervals * sizeof(double));
+        offset += intervals * sizeof(double);
+        if (axis.scale == LogScale && !(axis.nodes[0] > 0.0)) return fail("对数轴节点必须为正");
+        nodeCount *= rec.nodeCount;
+        axes.append(axis);
+    }
+    if (nodeCount != h.nodeCount) return fail("网格节点数不一致");
+    if (h.dataOffset + h.nodeCount * 2 * h.timeCount * sizeof(float) != h.payloadSize) return fail("曲线数据长度不一致");
+
+    m_type = (ModelSolver01_06::ModelType)h.modelType;
+    m_axes = axes;
+    m_strides.resize(axes.size());
+    qint64 stride = 1;
+    for (int a = axes.size() - 1; a >= 0; --a) {
+        m_strides[a] = stride;
+        stride *= axes[a].nodes.size();
+    }
+    m_timeCount = (int)h.timeCount;
+    m_tDMin = h.tDMin;
+    m_tDMax = h.tDMax;
+    m_dataOffset = (qint64)h.dataOffset;
+    return true;
+}
+
+void TypeCurveDatabase::close()
+{
+    if (m_data) m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    if (m_file.isOpen()) m_file.close();
+    m_axes.clear();
+    m_strides.clear();
+    m_timeCount = 0;
+    m_dataOffset = 0;
+}
+
+// ---------------- 查询 ----------------
+
+bool TypeCurveDatabase::lookup(const QMap<QString, double>& params, const QVector<double>& tD,
+                               QVector<double>& pD, QVector<double>& dpD) const
+{
+    if (!m_data) return false;
+
+    // 1. 各轴定位: 单节点轴只核对取值，离散轴取对应节点，其余轴求所在区间与上端点权重
+    //    (对数轴与线性轴分开记录，二者的角点在不同的空间中加权，见第 3 步)
+    qint64 baseNode = 0;
+    double estimatedError = 0.0;
+    QVector<qint64> logStride, linearStride;
+    QVector<double> logWeight, linearWeight;
+    for (int a = 0; a < m_axes.size(); ++a) {
+        const Axis& axis = m_axes[a];
+        if (!isRelevant(m_type, axis.name)) continue;
+        double x = keyValue(params, axis.name);
+        if (!std::isfinite(x)) return false;
+
+        const QVector<double>& nodes = axis.nodes;
+        if (nodes.size() == 1) {
+            if (!sameNode(x, nodes[0])) return false;
+            continue;
+        }
+        if (axis.scale == DiscreteScale) {
+            int idx = -1;
+            for (int i = 0; i < nodes.size(); ++i) {
+                if (sameNode(x, nodes[i])) { idx = i; break; }
+            }
+            if (idx < 0) return false;
+            baseNode += idx * m_strides[a];
+            continue;
+        }
+        if (axis.scale == LogScale && !(x > 0.0)) return false;
+
+        double u = axisCoordinate(axis.scale, x);
+        double lo = axisCoordinate(axis.scale, nodes.first());
+        double hi = axisCoordinate(axis.scale, nodes.last());
+        double tol = NODE_TOLERANCE * std::max(1.0, hi - lo);
+        if (u < lo - tol || u > hi + tol) return false;
+
+        int i = std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin() - 1;
+        i = std::max(0, std::min(i, (int)nodes.size() - 2));
+        double u0 = axisCoordinate(axis.scale, nodes[i]);
+        double u1 = axisCoordinate(axis.scale, nodes[i + 1]);
+        double w = std::max(0.0, std::min((u - u0) / (u1 - u0), 1.0));
+        // 线性插值的误差近似正比于 w(1 - w)，在区间中点处等于留出验证误差；各轴的误差估计相加
+        estimatedError += 4.0 * w * (1.0 - w) * axis.intervalError[i];
+        baseNode += i * m_strides[a];
+        if (w > 0.0) {
+            (axis.scale == LinearScale ? linearStride : logStride).append(m_strides[a]);
+            (axis.scale == LinearScale ? linearWeight : logWeight).append(w);
+        }
+    }
+
+    if (!(estimatedError <= INTERPOLATION_TOLERANCE)) return false;
+
+    // 2. 时间定位: 时间网格在 log10 tD 上等距
+    int n = tD.size();
+    double lMin = std::log10(m_tDMin), lMax = std::log10(m_tDMax);
+    double spacing = (lMax - lMin) / (m_timeCount - 1);
+    QVector<int> index(n, -1);
+    QVector<double> frac(n, 0.0);
+    for (int k = 0; k < n; ++k) {
+        if (tD[k] <= 1e-12) continue; // 与内核一致: 非正时间的 pD 为 0
+        double pos = (std::log10(tD[k]) - lMin) / spacing;
+        if (pos < -1e-9 || pos > m_timeCount - 1 + 1e-9) return false;
+        int j = std::max(0, std::min((int)std::floor(pos), m_timeCount - 2));
+        index[k] = j;
+        frac[k] = std::max(0.0, std::min(pos - j, 1.0));
+    }
+
+    // 3. 角点加权求和: 对数轴的角点在 log10 空间加权 (曲线随这些参数近似按幂律平移)，
+    //    线性轴 (表皮系数 S) 的角点在 pD 空间加权 (井储结束后 pD 近似为 S 的线性函数)；
+    //    权重为零的项不参与，避免 0 × NaN
+    QVector<double> sumP(n, 0.0), sumD(n, 0.0);
+    QVector<double> lp(n), ld(n);
+    int linearCorners = 1 << linearStride.size();
+    int logCorners = 1 << logStride.size();
+    for (int lc = 0; lc < linearCorners; ++lc) {
+        double linearW = 1.0;
+        qint64 linearNode = baseNode;
+        for (int b = 0; b < linearStride.size(); ++b) {
+            if (lc & (1 << b)) { linearW *= linearWeight[b]; linearNode += linearStride[b]; }
+            else linearW *= 1.0 - linearWeight[b];
+        }
+        if (linearW == 0.0) continue;
+
+        lp.fill(0.0);
+        ld.fill(0.0);
+        for (int c = 0; c < logCorners; ++c) {
+            double weight = 1.0;
+            qint64 node = linearNode;
+            for (int b = 0; b < logStride.size(); ++b) {
+                if (c & (1 << b)) { weight *= logWeight[b]; node += logStride[b]; }
+                else weight *= 1.0 - logWeight[b];
+            }
+            if (weight == 0.0) continue;
+
+            const float* pData = nodeData(node);
+            const float* dData = pData + m_timeCount;
+            for (int k = 0; k < n; ++k) {
+                int j = index[k];
+                if (j < 0) continue;
+                double s = frac[k];
+                double vp = pData[j], vd = dData[j];
+                if (s > 0.0) {
+                    vp = (1.0 - s) * vp + s * pData[j + 1];
+                    vd = (1.0 - s) * vd + s * dData[j + 1];
+                }
+                lp[k] += weight * vp;
+                ld[k] += weight * vd;
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            if (index[k] < 0) continue;
+            sumP[k] += linearW * std::pow(10.0, lp[k]);
+            sumD[k] += linearW * std::pow(10.0, ld[k]);
+        }
+    }
+
+    // 4. 还原为 pD 与导数，并按压敏系数换算 (与内核的摄动公式一致，导数按链式法则)
+    double gamaD = params.value("gamaD", 0.0);
+    pD.resize(n);
+    dpD.resize(n);
+    for (int k = 0; k < n; ++k) {
+        double p = (index[k] < 0 || std::isnan(sumP[k])) ? 0.0 : sumP[k];
+        double d = (index[k] < 0 || std::isnan(sumD[k])) ? 0.0 : sumD[k];
+        if (std::abs(gamaD) > 1e-9) {
+            double arg = 1.0 - gamaD * p;
+            if (arg > 1e-12) {
+                p = -1.0 / gamaD * std::log(arg);
+                d /= arg;
+            }
+        }
+        pD[k] = p;
+        dpD[k] = d;
+    }
+    return true;
+}
+
+// ---------------- 离线生成 ----------------
+
+bool TypeCurveDatabase::generate(ModelSolver01_06::ModelType type, const QVector<Axis>& axesIn,
+                                 const QMap<QString, double>& baseParams,
+                                 double tDMin, double tDMax, int timeCount,
+                                 const QString& path, QString* error,
+                                 const std::function<void(int done, int total)>& progress,
+                                 const std::atomic<bool>* cancel)
+{
+    auto fail = [&](const QString& message) {
+        if (error) *error = QString("%1: %2").arg(path, message);
+        return false;
+    };
+    if (!(tDMin > 0.0) || !(tDMax > tDMin) || timeCount < 2) return fail("时间网格无效");
+
+    // 1. 按 keyParameters() 的顺序整理网格轴，未给出或与模型无关的参数取 baseParams 中的值
+    const QStringList keys = keyParameters();
+    for (const Axis& axis : axesIn) {
+        if (!keys.contains(axis.name)) return fail(QString("未知参数 %1").arg(axis.name));
+    }
+    QVector<Axis> axes;
+    for (const QString& name : keys) {
+        Axis axis;
+        axis.name = name;
+        axis.scale = (name == "nf") ? DiscreteScale : LinearScale;
+        for (const Axis& given : axesIn) {
+            if (given.name == name && isRelevant(type, name)) axis = given;
+        }
+        if (axis.nodes.isEmpty()) {
+            double v = keyValue(baseParams, name);
+            if (!std::isfinite(v)) return fail(QString("参数 %1 的取值无效").arg(name));
+            axis.nodes.append(v);
+        }
+        for (int i = 1; i < axis.nodes.size(); ++i) {
+            if (!(axis.nodes[i] > axis.nodes[i - 1])) return fail(QString("参数 %1 的节点不是严格递增").arg(name));
+        }
+        if (axis.scale == LogScale && !(axis.nodes[0] > 0.0)) return fail(QString("参数 %1 的对数轴节点必须为正").arg(name));
+        axes.append(axis);
+    }
+
+    QVector<qint64> strides(axes.size());
+    qint64 nodeCount = 1;
+    for (int a = axes.size() - 1; a >= 0; --a) {
+        strides[a] = nodeCount;
+        nodeCount *= axes[a].nodes.size();
+    }
+
+    QVector<double> tD(timeCount);
+    double lMin = std::log10(tDMin), lMax = std::log10(tDMax);
+    for (int j = 0; j < timeCount; ++j) tD[j] = std::pow(10.0, lMin + (lMax - lMin) * j / (timeCount - 1));
+
+    // 2. 组装文件头与轴记录
+    qint64 headerSize = sizeof(FileHeader);
+    for (const Axis& axis : axes) headerSize += sizeof(AxisRecord) + (2 * axis.nodes.size() - 1) * sizeof(double);
+    qint64 dataOffset = (headerSize + 7) / 8 * 8;
+    qint64 payloadSize = dataOffset + nodeCount * 2 * timeCount * (qint64)sizeof(float);
+
+    QByteArray bytes(payloadSize + 4, '\0');
+    uchar* out = reinterpret_cast<uchar*>(bytes.data());
+
+    FileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FILE_VERSION;
+    h.modelType = (quint32)type;
+    h.axisCount = (quint32)axes.size();
+    h.timeCount = (quint32)timeCount;
+    h.nodeCount = (quint64)nodeCount;
+    h.dataOffset = (quint64)dataOffset;
+    h.payloadSize = (quint64)payloadSize;
+    h.tDMin = tDMin;
+    h.tDMax = tDMax;
+    std::memcpy(out, &h, sizeof(h));
+
+    // 区间验证误差在第 4 步测得后写入，这里先记下各轴的写入位置
+    QVector<qint64> errorOffsets;
+    qint64 offset = sizeof(FileHeader);
+    for (const Axis& axis : axes) {
+        AxisRecord rec;
+        std::memset(&rec, 0, sizeof(rec));
+        QByteArray name = axis.name.toLatin1().left(NAME_LENGTH);
+        std::memcpy(rec.name, name.constData(), name.size());
+        rec.scale = (quint32)axis.scale;
+        rec.nodeCount = (quint32)axis.nodes.size();
+        std::memcpy(out + offset, &rec, sizeof(rec));
+        offset += sizeof(rec);
+        std::memcpy(out + offset, axis.nodes.constData(), axis.nodes.size() * sizeof(double));
+        offset += axis.nodes.size() * sizeof(double);
+        errorOffsets.append(offset);
+        offset += (axis.nodes.size() - 1) * sizeof(double);
+    }
+
+    // 3. 逐节点计算曲线 (gamaD = 0，查询时解析换算)
+    // 各线程只读访问网格定义，只写入各自节点的数据区
+    float* curves = reinterpret_cast<float*>(out + dataOffset);
+    const QVector<Axis>& grid = axes;
+    const QVector<qint64>& gridStrides = strides;
+    ModelSolver01_06 solver(type);
+
+    // 网格节点的参数表；axis >= 0 时该轴改取 value (用于留出验证)
+    auto nodeParams = [&](qint64 node, int axis, double value) {
+        QMap<QString, double> p = baseParams;
+        p["gamaD"] = 0.0;
+        for (int a = 0; a < grid.size(); ++a) {
+            double v = (a == axis) ? value : grid[a].nodes[(node / gridStrides[a]) % grid[a].nodes.size()];
+            if (grid[a].name == "M12") { p["kf"] = v; p["km"] = 1.0; }
+            else p[grid[a].name] = v;
+        }
+        return p;
+    };
+    auto toLog = [](double v) {
+        return (v > 0.0 && std::isfinite(v)) ? (float)std::log10(v) : std::numeric_limits<float>::quiet_NaN();
+    };
+
+    // 验证任务: 各连续多节点轴的各区间 × VALIDATION_SAMPLES 个样本，
+    // 样本为随机网格节点 (第一个为各轴的中间节点)，固定种子使同一网格的结果可重复
+    QVector<QPair<int, int>> intervals;
+    for (int a = 0; a < axes.size(); ++a) {
+        if (axes[a].scale == DiscreteScale) continue;
+        for (int i = 0; i + 1 < axes[a].nodes.size(); ++i) intervals.append(qMakePair(a, i));
+    }
+    QVector<qint64> samples(VALIDATION_SAMPLES);
+    std::mt19937_64 random(20240601);
+    for (int s = 0; s < VALIDATION_SAMPLES; ++s) {
+        qint64 node = 0;
+        for (int a = 0; a < axes.size(); ++a) {
+            int n = axes[a].nodes.size();
+            node += (s == 0 ? n / 2 : (int)(random() % (quint64)n)) * strides[a];
+        }
+        samples[s] = node;
+    }
+    int validationCount = intervals.size() * VALIDATION_SAMPLES;
+    int total = (int)nodeCount + validationCount;
+
+    std::atomic<int> done(0);
+    ParallelFor::run((int)nodeCount, [&](int node) {
+        QVector<double> pd, dpd;
+        solver.calculateDimensionlessCurve(nodeParams(node, -1, 0.0), tD, true, pd, dpd);
+        float* dst = curves + (qint64)node * 2 * timeCount;
+        for (int j = 0; j < timeCount; ++j) {
+            dst[j] = toLog(pd[j]);
+            dst[timeCount + j] = toLog(dpd[j]);
+        }
+        int finished = ++done;
+        if (progress) progress(finished, total);
+    }, cancel);
+    if (cancel && cancel->load()) return fail("已取消");
+
+    // 4. 留出验证: 区间中点处直接计算的曲线与两端节点按查询规则插值的结果之差
+    QVector<double> sampleError(validationCount, 0.0);
+    double* errorData = sampleError.data();
+    ParallelFor::run(validationCount, [&](int task) {
+        int a = intervals[task / VALIDATION_SAMPLES].first;
+        int i = intervals[task / VALIDATION_SAMPLES].second;
+        const Axis& axis = grid[a];
+        qint64 sample = samples[task % VALIDATION_SAMPLES];
+        qint64 node0 = sample + (i - (sample / gridStrides[a]) % axis.nodes.size()) * gridStrides[a];
+        const float* c0 = curves + node0 * 2 * timeCount;
+        const float* c1 = c0 + gridStrides[a] * 2 * timeCount;
+
+        bool linear = (axis.scale == LinearScale);
+        double lo = axis.nodes[i], hi = axis.nodes[i + 1];
+        double mid = linear ? 0.5 * (lo + hi) : std::sqrt(lo * hi);
+        QVector<double> pd, dpd;
+        solver.calculateDimensionlessCurve(nodeParams(node0, a, mid), tD, true, pd, dpd);
+        QVector<float> exact(2 * timeCount);
+        for (int j = 0; j < timeCount; ++j) {
+            exact[j] = toLog(pd[j]);
+            exact[timeCount + j] = toLog(dpd[j]);
+        }
+
+        double spacing = (lMax - lMin) / (timeCount - 1);
+        double worst = 0.0;
+        for (int j = 1; j + 1 < timeCount; ++j) {
+            // 只比较三条曲线在该点两侧都正常的时间点
+            bool valid = true;
+            for (int seg = j; seg <= j + 1; ++seg) {
+                valid = valid && physicalSegment(c0, seg, spacing) && physicalSegment(c1, seg, spacing)
+                        && physicalSegment(exact.constData(), seg, spacing);
+            }
+            if (!valid) continue;
+            for (int k = j; k < 2 * timeCount; k += timeCount) {
+                double blended = linear ? std::log10(0.5 * (std::pow(10.0, (double)c0[k]) + std::pow(10.0, (double)c1[k])))
+                                        : 0.5 * ((double)c0[k] + (double)c1[k]);
+                double deviation = std::abs(blended - (double)exact[k]);
+                if (std::isfinite(deviation)) worst = std::max(worst, deviation);
+            }
+        }
+        errorData[task] = worst;
+        int finished = ++done;
+        if (progress) progress(finished, total);
+    }, cancel);
+    if (cancel && cancel->load()) return fail("已取消");
+
+    for (int k = 0; k < intervals.size(); ++k) {
+        double worst = 0.0;
+        for (int s = 0; s < VALIDATION_SAMPLES; ++s) worst = std::max(worst, sampleError[k * VALIDATION_SAMPLES + s]);
+        std::memcpy(out + errorOffsets[intervals[k].first] + intervals[k].second * sizeof(double), &worst, sizeof(worst));
+    }
+
+    // 5. 校验和并写出
+    quint32 crc = crc32(out, payloadSize);
+    std::memcpy(out + payloadSize, &crc, sizeof(crc));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return fail("无法写入文件");
+    if (file.write(bytes) != bytes.size() || !file.commit()) return fail("写入文件失败");
+    return true;
+}
+
+QVector<TypeCurveDatabase::Axis> TypeCurveDatabase::defaultAxes(ModelSolver01_06::ModelType type)
+{
+    QVector<Axis> axes = {
+        { "M12",     LogScale,      { 1.0, 10.0, 100.0 } },
+        { "omega1",  LogScale,      { 0.05, 0.2, 0.8 } },
+        { "omega2",  LogScale,      { 0.01, 0.05, 0.25 } },
+        { "lambda1", LogScale,      { 1e-5, 1e-3, 1e-1 } },
+        { "rmD",     LogScale,      { 1.5, 3.0, 6.0 } },
+        { "LfD",     LogScale,      { 0.05, 0.1, 0.3 } },
+        { "nf",      DiscreteScale, { 2.0, 4.0, 8.0 } }
+    };
+    if (ModelSolver01_06::hasWellboreStorage(type)) {
+        axes.append({ "cD", LogScale,    { 1e-3, 1e-2, 1e-1 } });
+        axes.append({ "S",  LinearScale, { 0.0, 2.0, 8.0 } });
+    }
+    if (!ModelSolver01_06::isInfiniteBoundary(type)) {
+        axes.append({ "reD", LogScale, { 8.0, 20.0, 50.0 } });
+    }
+    return axes;
+}
+
+QMap<QString, double> TypeCurveDatabase::defaultBaseParams()
+{
+    // 与 ModelManager::getDefaultParameters 中的模型参数一致，反演使用高精度 N = 8
+    QMap<QString, double> p;
+    p.insert("kf", 1e-3);
+    p.insert("km", 1e-4);
+    p.insert("LfD", 0.1);
+    p.insert("rmD", 4.0);
+    p.insert("reD", 10.0);
+    p.insert("omega1", 0.4);
+    p.insert("omega2", 0.08);
+    p.insert("lambda1", 1e-3);
+    p.insert("cD", 0.01);
+    p.insert("S", 1.0);
+    p.insert("nf", 4.0);
+    p.insert("N", 8.0);
+    return p;
+}
+
+bool TypeCurveDatabase::generateDefaultDatabases(const QString& dir, QString* error)
+{
+    if (!QDir().mkpath(dir)) {
+        if (error) *error = QString("%1: 无法创建目录").arg(dir);
+        return false;
+    }
+    for (int t = ModelSolver01_06::Model_1; t <= ModelSolver01_06::Model_6; ++t) {
+        ModelSolver01_06::ModelType type = (ModelSolver01_06::ModelType)t;
+        QString path = QDir(dir).filePath(fileName(type));
+        qInfo().noquote() << "生成样板曲线库" << path;
+        std::atomic<int> lastPercent(-1);
+        bool ok = generate(type, defaultAxes(type), defaultBaseParams(), 1e-7, 1e5, 121, path, error,
+                           [&lastPercent](int done, int total) {
+                               // 进度在工作线程中回调，这里只做粗略输出
+                               int percent = done * 100 / total;
+                               if (lastPercent.exchange(percent) != percent && percent % 10 == 0)
+                                   qInfo().noquote() << QString("  %1% (%2/%3)").arg(percent).arg(done).arg(total);
+                           });
+        if (!ok) return false;
+
+        // 输出各插值区间的留出验证误差，超过容限的区间查询时回退到内核计算
+        TypeCurveDatabase db;
+        if (!db.open(path, error)) return false;
+        for (const Axis& axis : db.axes()) {
+            if (axis.scale == DiscreteScale) continue;
+            for (int i = 0; i < axis.intervalError.size(); ++i) {
+                double e = axis.intervalError[i];
+                qInfo().noquote() << QString("  %1 [%2, %3]: 插值误差 %4 (log10)%5")
+                                         .arg(axis.name).arg(axis.nodes[i]).arg(axis.nodes[i + 1])
+                                         .arg(e, 0, 'f', 4).arg(e <= INTERPOLATION_TOLERANCE ? "" : "，超限");
+            }
+        }
+    }
+    return true;
+}
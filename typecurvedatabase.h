@@ -0,0 +1,126 @@
+/*
+ * typecurvedatabase.h
+ * 文件作用：无量纲样板曲线库头文件
+ * 功能描述：
+ * 1. 离线生成: 对某一模型在关键无量纲参数 (M12、CD、S、omega1/2、lambda1、rmD、reD、LfD、nf) 的网格上
+ *    逐节点计算 pD(tD) 及其导数，写入带版本号与 CRC32 校验的二进制文件
+ * 2. 在线查询: 程序启动时以 QFile::map 内存映射曲线库，按参数做多线性插值 (log10 pD 对 log10 tD 线性插值)，
+ *    不再调用拉普拉斯空间核函数，用于交互式曲线预览
+ * 3. 压敏系数 gamaD 不作为网格轴: 曲线库按 gamaD = 0 生成，查询时按摄动公式解析换算
+ * 4. 参数超出网格范围、离散参数 (nf) 不在节点上或单节点轴的取值不一致时查询失败，调用方应回退到内核计算
+ * 5. 留出验证: 生成时在每个插值区间的中点 (其余参数取若干网格节点) 直接计算曲线，与相邻两节点插值的结果比较，
+ *    记录该区间的最大偏差；查询时按各轴的插值位置估计误差，超过 INTERPOLATION_TOLERANCE 时同样查询失败
+ *
+ * 文件格式 (小端序):
+ *   FileHeader | AxisRecord + 节点值 (double) + 区间验证误差 (double，节点数 - 1 个) × 轴数 | 填充至 8 字节对齐 |
+ *   曲线数据 float32 [节点数][2][时间点数] (log10 pD、log10 导数，非正值记为 NaN) | CRC32 (覆盖之前的全部字节)
+ *   网格节点按轴的先后顺序排列，最后一个轴变化最快
+ */
+
+#ifndef TYPECURVEDATABASE_H
+#define TYPECURVEDATABASE_H
+
+#include "modelsolver01-06.h"
+
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+class TypeCurveDatabase
+{
+public:
+    static const quint32 FILE_VERSION = 2;
+
+    // 查询允许的插值误差估计 (log10 pD 与 log10 导数之差，约 2.3%)
+    static constexpr double INTERPOLATION_TOLERANCE = 0.01;
+    // 每个插值区间的验证样本数 (其余参数所取的网格节点组合数)
+    static const int VALIDATION_SAMPLES = 8;
+
+    // 网格轴的插值方式
+    enum AxisScale {
+        LinearScale = 0,    // 线性空间插值 (如 S)
+        LogScale = 1,       // log10 空间插值 (正值参数)
+        DiscreteScale = 2   // 离散参数，只接受节点上的取值 (如 nf)
+    };
+
+    struct Axis {
+        QString name;            // 关键参数名 (见 keyParameters())
+        AxisScale scale;
+        QVector<double> nodes;   // 严格递增；只有一个节点时表示该参数固定
+        QVector<double> intervalError;   // 各区间 [nodes[i], nodes[i+1]] 的留出验证误差 (log10，生成时测得)
+    };
+
+    TypeCurveDatabase();
+    ~TypeCurveDatabase();
+
+    // 内存映射并校验曲线库文件 (魔数、版本、长度、CRC32)；失败时返回 false 并给出原因
+    bool open(const QString& path, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    ModelSolver01_06::ModelType modelType() const { return m_type; }
+    const QVector<Axis>& axes() const { return m_axes; }
+    double tDMin() const { return m_tDMin; }
+    double tDMax() const { return m_tDMax; }
+    int timeCount() const { return m_timeCount; }
+    qint64 nodeCount() const;
+
+    // 网格节点 node 在第 axis 个轴上的参数值
+    double nodeParameter(qint64 node, int axis) const;
+    // 网格节点的 log10 导数曲线 (timeCount() 个点，在 log10 tD 上等距，非正值为 NaN)
+    const float* logDerivative(qint64 node) const { return nodeData(node) + m_timeCount; }
+
+    // 在 tD 上插值得到 pD 及其导数；参数不在曲线库覆盖范围内或插值误差估计超限时返回 false
+    bool lookup(const QMap<QString, double>& params, const QVector<double>& tD,
+                QVector<double>& pD, QVector<double>& dpD) const;
+
+    // 曲线库涉及的关键无量纲参数，以及由参数表得到其取值的方式
+    // (M12 = kf/km，其余参数直接取参数表中的值，缺省值与计算内核一致)
+    static QStringList keyParameters();
+    static double keyValue(const QMap<QString, double>& params, const QString& name);
+
+    // 离线生成曲线库: axes 中未列出的关键参数取 baseParams 中的值作为单节点轴
+    // 每个网格节点计算一条高精度曲线，各节点在模型线程池中并行计算；随后对各插值区间做留出验证
+    static bool generate(ModelSolver01_06::ModelType type, const QVector<Axis>& axes,
+                         const QMap<QString, double>& baseParams,
+                         double tDMin, double tDMax, int timeCount,
+                         const QString& path, QString* error = nullptr,
+                         const std::function<void(int done, int total)>& progress = {},
+                         const std::atomic<bool>* cancel = nullptr);
+
+    // 各模型的默认网格与默认参数 (用于命令行 --generate-typecurves)
+    static QVector<Axis> defaultAxes(ModelSolver01_06::ModelType type);
+    static QMap<QString, double> defaultBaseParams();
+
+    // 在 dir 下生成 6 个模型的默认曲线库
+    static bool generateDefaultDatabases(const QString& dir, QString* error = nullptr);
+
+    // 模型对应的曲线库文件名
+    static QString fileName(ModelSolver01_06::ModelType type);
+
+    static quint32 crc32(const uchar* data, qint64 size);
+
+    // 参数是否影响该模型的曲线 (CD、S 仅对变井储模型，reD 仅对有界模型)
+    static bool isRelevant(ModelSolver01_06::ModelType type, const QString& name);
+
+private:
+    // 网格节点的曲线数据 (2 × m_timeCount 个 float)
+    const float* nodeData(qint64 node) const;
+
+private:
+    QFile m_file;
+    const uchar* m_data;              // 映射后的文件内容
+    ModelSolver01_06::ModelType m_type;
+    QVector<Axis> m_axes;
+    QVector<qint64> m_strides;        // 各轴的节点步长 (以网格节点计)
+    int m_timeCount;
+    double m_tDMin;
+    double m_tDMax;
+    qint64 m_dataOffset;
+};
+
+#endif // TYPECURVEDATABASE_H
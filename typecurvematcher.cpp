@@ -0,0 +1,294 @@
+/*
+ * typecurvematcher.cpp
+ * 文件作用：样板曲线快速匹配实现文件
+ * 功能描述：
+ * 1. 特征库只保存每个节点重新采样后的曲线 (float)；KD 树的每个点记为 (节点, 起始位置, 窗口均值)，
+ *    坐标在访问时由曲线与均值算出，不展开存储全部特征向量
+ * 2. KD 树为静态平衡树: 按深度轮换划分维，以 nth_element 取中位点，叶子不超过 LEAF_SIZE 个点
+ * 3. 含 NaN (导数非正) 的窗口不进入 KD 树
+ * 4. 实测导数按特征间隔分箱取中位数，空箱按相邻箱线性插值，首尾的空箱去掉
+ */
+
+#include "typecurvematcher.h"
+
+#include <QMutexLocker>
+#include <QPair>
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace {
+
+const int LEAF_SIZE = 8;
+
+double median(QVector<double>& values)
+{
+    int mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double m = values[mid];
+    if (values.size() % 2 == 0) {
+        m = 0.5 * (m + *std::max_element(values.begin(), values.begin() + mid));
+    }
+    return m;
+}
+
+} // namespace
+
+// ---------------- KD 树 ----------------
+
+class TypeCurveMatcher::Tree
+{
+public:
+    struct Point {
+        qint32 node;
+        qint32 offset;   // 窗口在重新采样曲线中的起始位置
+        float mean;      // 窗口内 log10 导数的均值
+    };
+
+    Tree(const TypeCurveDatabase* db, int dimension);
+
+    // k 近邻搜索，结果按距离平方递增
+    QVector<QPair<double, Point>> nearest(const QVector<double>& query, int k) const;
+
+    int dimension() const { return m_dim; }
+    // 起始位置 offset 对应的 log10 tD
+    double logTD(int offset) const { return m_lMin + offset * (FEATURE_SPACING / SHIFT_STEPS); }
+
+private:
+    double coord(const Point& p, int d) const
+    {
+        return m_curves[(qint64)p.node * m_length + p.offset + d * SHIFT_STEPS] - p.mean;
+    }
+    void build(int lo, int hi, int depth);
+    void search(int lo, int hi, int depth, const QVector<double>& q, int k,
+                std::priority_queue<QPair<double, int>>& heap) const;
+
+    int m_dim;
+    int m_length;            // 每个节点重新采样后的点数
+    double m_lMin;
+    QVector<float> m_curves; // [节点][m_length]
+    QVector<Point> m_points;
+};
+
+TypeCurveMatcher::Tree::Tree(const TypeCurveDatabase* db, int dimension)
+    : m_dim(dimension)
+{
+    // 1. 各节点曲线按 FEATURE_SPACING / SHIFT_STEPS 重新采样 (在 log10 tD 上线性插值)
+    int timeCount = db->timeCount();
+    m_lMin = std::log10(db->tDMin());
+    double lMax = std::log10(db->tDMax());
+    double dbSpacing = (lMax - m_lMin) / (timeCount - 1);
+    double step = FEATURE_SPACING / SHIFT_STEPS;
+    m_length = (int)std::floor((lMax - m_lMin) / step + 1e-9) + 1;
+
+    qint64 nodeCount = db->nodeCount();
+    m_curves.resize(nodeCount * m_length);
+    for (qint64 node = 0; node < nodeCount; ++node) {
+        const float* src = db->logDerivative(node);
+        float* dst = m_curves.data() + node * m_length;
+        for (int s = 0; s < m_length; ++s) {
+            double pos = s * step / dbSpacing;
+            int j = std::min((int)std::floor(pos), timeCount - 2);
+            double frac = std::min(pos - j, 1.0);
+            dst[s] = (float)((1.0 - frac) * src[j] + frac * src[j + 1]);
+        }
+    }
+
+    // 2. 收集不含 NaN 的窗口
+    int span = (m_dim - 1) * SHIFT_STEPS;
+    for (qint64 node = 0; node < nodeCount; ++node) {
+        const float* curve = m_curves.constData() + node * m_length;
+        for (int offset = 0; offset + span < m_length; ++offset) {
+            double sum = 0.0;
+            bool valid = true;
+            for (int d = 0; d < m_dim && valid; ++d) {
+                float v = curve[offset + d * SHIFT_STEPS];
+                valid = std::isfinite(v);
+                sum += v;
+            }
+            if (valid) m_points.append(Point{ (qint32)node, offset, (float)(sum / m_dim) });
+        }
+    }
+
+    build(0, m_points.size(), 0);
+}
+
+void TypeCurveMatcher::Tree::build(int lo, int hi, int depth)
+{
+    if (hi - lo <= LEAF_SIZE) return;
+    int mid = (lo + hi) / 2;
+    int d = depth % m_dim;
+    std::nth_element(m_points.begin() + lo, m_points.begin() + mid, m_points.begin() + hi,
+                     [this, d](const Point& a, const Point& b) { return coord(a, d) < coord(b, d); });
+    build(lo, mid, depth + 1);
+    build(mid + 1, hi, depth + 1);
+}
+
+void TypeCurveMatcher::Tree::search(int lo, int hi, int depth, const QVector<double>& q, int k,
+                                    std::priority_queue<QPair<double, int>>& heap) const
+{
+    auto consider = [&](int i) {
+        double dist = 0.0;
+        for (int d = 0; d < m_dim; ++d) {
+            double diff = q[d] - coord(m_points[i], d);
+            dist += diff * diff;
+        }
+        if ((int)heap.size() < k) heap.push(qMakePair(dist, i));
+        else if (dist < heap.top().first) { heap.pop(); heap.push(qMakePair(dist, i)); }
+    };
+
+    if (hi - lo <= LEAF_SIZE) {
+        for (int i = lo; i < hi; ++i) consider(i);
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    int d = depth % m_dim;
+    consider(mid);
+
+    double diff = q[d] - coord(m_points[mid], d);
+    if (diff < 0.0) {
+        search(lo, mid, depth + 1, q, k, heap);
+        if ((int)heap.size() < k || diff * diff < heap.top().first) search(mid + 1, hi, depth + 1, q, k, heap);
+    } else {
+        search(mid + 1, hi, depth + 1, q, k, heap);
+        if ((int)heap.size() < k || diff * diff < heap.top().first) search(lo, mid, depth + 1, q, k, heap);
+    }
+}
+
+QVector<QPair<double, TypeCurveMatcher::Tree::Point>> TypeCurveMatcher::Tree::nearest(const QVector<double>& query, int k) const
+{
+    std::priority_queue<QPair<double, int>> heap;
+    search(0, m_points.size(), 0, query, k, heap);
+
+    QVector<QPair<double, Point>> result(heap.size());
+    for (int i = result.size() - 1; i >= 0; --i) {
+        result[i] = qMakePair(heap.top().first, m_points[heap.top().second]);
+        heap.pop();
+    }
+    return result;
+}
+
+// ---------------- 匹配 ----------------
+
+TypeCurveMatcher::TypeCurveMatcher()
+{
+}
+
+TypeCurveMatcher::~TypeCurveMatcher()
+{
+}
+
+void TypeCurveMatcher::setDatabases(const QList<const TypeCurveDatabase*>& databases)
+{
+    QMutexLocker locker(&m_mutex);
+    m_databases = databases;
+    m_trees.clear();
+    m_trees.resize(databases.size());
+}
+
+std::shared_ptr<const TypeCurveMatcher::Tree> TypeCurveMatcher::tree(int dbIndex, int dimension) const
+{
+    QMutexLocker locker(&m_mutex);
+    std::shared_ptr<const Tree>& cached = m_trees[dbIndex];
+    if (!cached || cached->dimension() != dimension) {
+        cached = std::make_shared<const Tree>(m_databases[dbIndex], dimension);
+    }
+    return cached;
+}
+
+QVector<TypeCurveMatch> TypeCurveMatcher::match(const QVector<double>& t, const QVector<double>& d,
+                                                const QMap<QString, double>& basicParams, int count) const
+{
+    QVector<TypeCurveMatch> result;
+    if (m_databases.isEmpty() || count <= 0) return result;
+
+    // 1. 实测导数在 log10 t 上按 FEATURE_SPACING 分箱取中位数
+    QVector<double> lt, ld;
+    for (int i = 0; i < t.size() && i < d.size(); ++i) {
+        if (t[i] > 0.0 && d[i] > 0.0) { lt.append(std::log10(t[i])); ld.append(std::log10(d[i])); }
+    }
+    if (lt.isEmpty()) return result;
+    double xMin = *std::min_element(lt.begin(), lt.end());
+    double xMax = *std::max_element(lt.begin(), lt.end());
+    int binCount = (int)std::floor((xMax - xMin) / FEATURE_SPACING + 0.5) + 1;
+
+    QVector<QVector<double>> bins(binCount);
+    for (int i = 0; i < lt.size(); ++i) {
+        int b = (int)std::floor((lt[i] - xMin) / FEATURE_SPACING + 0.5);
+        bins[std::max(0, std::min(b, binCount - 1))].append(ld[i]);
+    }
+    QVector<int> filled;
+    QVector<double> level(binCount, 0.0);
+    for (int b = 0; b < binCount; ++b) {
+        if (bins[b].isEmpty()) continue;
+        level[b] = median(bins[b]);
+        filled.append(b);
+    }
+    if (filled.isEmpty()) return result;
+    for (int f = 0; f + 1 < filled.size(); ++f) {
+        int b0 = filled[f], b1 = filled[f + 1];
+        for (int b = b0 + 1; b < b1; ++b) level[b] = level[b0] + (level[b1] - level[b0]) * (b - b0) / (b1 - b0);
+    }
+
+    // 2. 取最后 MAX_DIMENSION 个箱作为特征窗口并减去均值
+    int last = filled.last();
+    int first = std::max(filled.first(), last - MAX_DIMENSION + 1);
+    int dim = last - first + 1;
+    if (dim < MIN_DIMENSION) return result;
+
+    QVector<double> query(dim);
+    double obsMean = 0.0;
+    for (int i = 0; i < dim; ++i) obsMean += level[first + i];
+    obsMean /= dim;
+    for (int i = 0; i < dim; ++i) query[i] = level[first + i] - obsMean;
+    double obsStart = xMin + first * FEATURE_SPACING;
+
+    // 3. 各模型分别做 k 近邻搜索 (多取一些，同一节点的不同平移只保留最近者)
+    double phi = basicParams.value("phi", 0.05);
+    double mu = basicParams.value("mu", 0.5);
+    double Ct = basicParams.value("Ct", 5e-4);
+    double q = basicParams.value("q", 5.0);
+    double B = basicParams.value("B", 1.05);
+    double h = basicParams.value("h", 20.0);
+
+    for (int i = 0; i < m_databases.size(); ++i) {
+        const TypeCurveDatabase* db = m_databases[i];
+        std::shared_ptr<const Tree> kd = tree(i, dim);
+        QVector<QPair<double, Tree::Point>> hits = kd->nearest(query, count * 4);
+
+        QVector<qint32> seen;
+        for (const auto& hit : hits) {
+            const Tree::Point& p = hit.second;
+            if (seen.contains(p.node)) continue;
+            seen.append(p.node);
+
+            // 压力拟合点: p = factor * pD；时间拟合点: tD = A * t
+            double factor = std::pow(10.0, obsMean - p.mean);
+            double A = std::pow(10.0, kd->logTD(p.offset) - obsStart);
+            double kf = 1.842e-3 * q * mu * B / (h * factor);
+            double L = std::sqrt(14.4 * kf / (phi * mu * Ct * A));
+
+            TypeCurveMatch m;
+            m.type = db->modelType();
+            m.distance = std::sqrt(hit.first / dim);
+            m.params.insert("kf", kf);
+            m.params.insert("L", L);
+            for (int a = 0; a < db->axes().size(); ++a) {
+                const QString& name = db->axes()[a].name;
+                if (!TypeCurveDatabase::isRelevant(m.type, name)) continue;
+                double v = db->nodeParameter(p.node, a);
+                if (name == "M12") m.params.insert("km", kf / v);
+                else if (name == "LfD") { m.params.insert("LfD", v); m.params.insert("Lf", v * L); }
+                else m.params.insert(name, v);
+            }
+            result.append(m);
+            if (seen.size() >= count) break;
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(),
+                     [](const TypeCurveMatch& a, const TypeCurveMatch& b) { return a.distance < b.distance; });
+    if (result.size() > count) result.resize(count);
+    return result;
+}
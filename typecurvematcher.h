@@ -0,0 +1,74 @@
+/*
+ * typecurvematcher.h
+ * 文件作用：样板曲线快速匹配头文件
+ * 功能描述：
+ * 1. 由已加载的样板曲线库构造导数特征库: 每个网格节点的 log10 导数曲线按 0.25 个对数周期重新采样，
+ *    任取一段窗口 (窗口内采样间隔 0.5 个对数周期) 减去均值后作为一个特征向量，
+ *    即双对数图上沿两个坐标轴平移不变的曲线形状
+ * 2. 实测导数按同样的方式归一化后，在各模型的 KD 树中做 k 近邻搜索，返回形状最接近的若干个模型与参数
+ * 3. 匹配窗口的时间平移与压力平移分别给出 L 与 kf (压力拟合点定 kf，时间拟合点定 L)，
+ *    其余参数取网格节点上的值 (km = kf / M12，Lf = LfD * L)
+ * 4. KD 树按窗口长度在首次查询时建立并缓存，match() 可在多个线程中同时调用
+ */
+
+#ifndef TYPECURVEMATCHER_H
+#define TYPECURVEMATCHER_H
+
+#include "typecurvedatabase.h"
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <memory>
+
+// 一个匹配结果
+struct TypeCurveMatch
+{
+    ModelSolver01_06::ModelType type;
+    QMap<QString, double> params;   // 匹配得到的参数 (只含曲线库涉及的参数与 kf、km、L、Lf)
+    double distance;                // 形状偏差: 归一化 log10 导数的均方根差 (对数周期)
+};
+
+class TypeCurveMatcher
+{
+public:
+    TypeCurveMatcher();
+    ~TypeCurveMatcher();
+
+    // 设置特征库来源 (曲线库由调用方持有，须在本对象使用期间保持打开)；清空已建立的 KD 树
+    void setDatabases(const QList<const TypeCurveDatabase*>& databases);
+    bool isEmpty() const { return m_databases.isEmpty(); }
+
+    /**
+     * @brief 按实测导数的形状匹配样板曲线
+     * @param t 实测时间 (h)
+     * @param d 实测压力导数 (MPa)，非正值忽略
+     * @param basicParams 基础参数 (phi、mu、Ct、q、B、h)，用于把拟合点换算为 kf 与 L
+     * @param count 返回的结果数 (各结果的模型或网格节点互不相同)
+     * @return 按形状偏差递增排列的匹配结果；实测数据不足或没有曲线库时为空
+     */
+    QVector<TypeCurveMatch> match(const QVector<double>& t, const QVector<double>& d,
+                                  const QMap<QString, double>& basicParams, int count) const;
+
+    // 特征采样间隔 (对数周期)，以及特征库曲线相对于它的细分倍数 (决定时间拟合点的分辨率)
+    static constexpr double FEATURE_SPACING = 0.5;
+    static constexpr int SHIFT_STEPS = 2;
+    // 特征向量的维数范围: 实测导数至少覆盖 2 个对数周期，超过 6 个对数周期时只取最后 6 个
+    static const int MIN_DIMENSION = 5;
+    static const int MAX_DIMENSION = 13;
+
+private:
+    class Tree;
+
+    // 某一模型在指定特征维数下的 KD 树 (首次使用时建立)
+    std::shared_ptr<const Tree> tree(int dbIndex, int dimension) const;
+
+private:
+    QList<const TypeCurveDatabase*> m_databases;
+
+    mutable QMutex m_mutex;
+    mutable QVector<std::shared_ptr<const Tree>> m_trees;   // 按曲线库索引，只缓存最近一次使用的维数
+};
+
+#endif // TYPECURVEMATCHER_H
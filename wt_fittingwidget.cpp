@@ -6,6 +6,11 @@
  * 2. 实现观测数据的加载逻辑。
  * 修改记录: 修复了将压力数据强制转换为压差 (Delta P) 的问题，现在支持直接加载和绘制实测压力 (Pressure)。
  * 3. 核心算法实现：完整实现了 Levenberg-Marquardt (LM) 非线性最小二乘拟合算法。
+ *    可选 Broyden 秩一更新雅可比矩阵，仅在进展停滞或每隔若干次迭代时重新完整计算。
+ *    拟合在按对数时间抽稀后的观测数据上进行 (残差按区间样本数加权)，绘图仍显示全部数据。
+ *    可选多起点全局搜索：拉丁超立方起点上并行运行短 LM，最优者再迭代至收敛。
+ *    可选差分进化 (DE) 拟合：每一代的全部候选参数在模型线程池中并行计算。
+ *    快速匹配：加载观测数据后按导数形状在样板曲线库中检索候选模型与参数，各候选做短 LM 修正后采用最优者。
  * 4. 提供丰富的交互功能：手动调整参数、权重滑块、模型选择、图表视图控制。
  * 5. 提供结果输出功能：导出拟合参数、导出图表图片、生成 HTML 分析报告。
  */
@@ -16,7 +21,9 @@
 #include "modelselect.h"
 #include "fittingdatadialog.h"
 #include "pressurederivativecalculator.h"
-#include "pressurederivativecalculator1.h"
+#include "derivativesmoother.h"
+#include "fittingdatareducer.h"
+#include "parallelfor.h"
 
 #include <QtConcurrent>
 #include <QMessageBox>
@@ -36,8 +43,17 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QBuffer>
+#include <QRandomGenerator>
+#include <algorithm>
 #include <Eigen/Dense>
 
+// 参数是否在 log10 空间中搜索与求导：下限为正且不是 S、nf
+// (差分进化、拉丁超立方抽样、LM 参数更新与雅可比矩阵共用此规则)
+static bool isLogParameter(const FitParameter& p)
+{
+    return p.min > 1e-12 && p.name != "S" && p.name != "nf";
+}
+
 // ===========================================================================
 // 构造与析构
 // ===========================================================================
@@ -53,7 +69,9 @@ FittingWidget::FittingWidget(QWidget *parent) :
     m_projectModel(nullptr),
     m_plotTitle(nullptr),
     m_currentModelType(ModelManager::Model_1),
-    m_isFitting(false)
+    m_quickMatchCandidateCount(0),
+    m_isFitting(false),
+    m_stopRequested(false)
 {
     // 加载 UI 布局
     ui->setupUi(this);
@@ -322,15 +340,17 @@ void FittingWidget::on_btnLoadData_clicked() {
         // 注意：压力导数 dP/dt 等同于 d(DeltaP)/dt，因此使用原始压力计算导数在数值上是一致的（仅方向可能相反，但通常取绝对值）
         finalDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(rawTime, finalPressure, 0.15);
 
-        // 如果开启了平滑，调用静态平滑方法处理计算结果
+        // 如果开启了平滑，按所选方法平滑计算结果
         if (settings.enableSmoothing) {
-            finalDeriv = PressureDerivativeCalculator1::smoothData(finalDeriv, settings.smoothingSpan);
+            finalDeriv = DerivativeSmoother::smooth(rawTime, finalDeriv,
+                                                    (DerivativeSmoother::Method)settings.smoothingMethod, settings.smoothingSpan);
         }
     } else {
         // 情况B: 用户选择了已有导数列
         // 如果用户在已有导数的基础上仍要求平滑，则进行平滑处理
         if (settings.enableSmoothing) {
-            finalDeriv = PressureDerivativeCalculator1::smoothData(finalDeriv, settings.smoothingSpan);
+            finalDeriv = DerivativeSmoother::smooth(rawTime, finalDeriv,
+                                                    (DerivativeSmoother::Method)settings.smoothingMethod, settings.smoothingSpan);
         }
 
         // 确保导数向量长度与时间向量一致（防止外部数据缺失）
@@ -352,6 +372,14 @@ void FittingWidget::on_btnLoadData_clicked() {
  * @param d 导数向量
  */
 void FittingWidget::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d) {
+    applyObservedData(t, p, d);
+    if(ui->chkQuickMatch->isChecked()) startQuickMatch();
+}
+
+/**
+ * @brief 保存观测数据并更新绘图 (不触发快速匹配)
+ */
+void FittingWidget::applyObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d) {
     m_obsTime = t;
     m_obsPressure = p;
     m_obsDerivative = d;
@@ -433,16 +461,34 @@ void FittingWidget::on_btnRunFit_clicked() {
     m_stopRequested = false;
     ui->btnRunFit->setEnabled(false);
 
+    prepareFittingData();
+
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_paramChart->getParameters();
     double w = ui->sliderWeight->value() / 100.0;
+    bool useBroyden = ui->chkBroyden->isChecked();
+    FitEngine engine = (FitEngine)ui->comboGlobalSearch->currentIndex();
+    int starts = ui->spinStarts->value();
 
     // 使用 QtConcurrent 在后台线程运行拟合优化任务，避免阻塞 UI 主线程
-    (void)QtConcurrent::run([this, modelType, paramsCopy, w](){
-        runOptimizationTask(modelType, paramsCopy, w);
+    (void)QtConcurrent::run([this, modelType, paramsCopy, w, useBroyden, engine, starts](){
+        runOptimizationTask(modelType, paramsCopy, w, useBroyden, engine, starts);
     });
 }
 
+/**
+ * @brief 按对数时间抽稀观测数据，拟合线程只读取抽稀后的数据
+ */
+void FittingWidget::prepareFittingData() {
+    ReducedFittingData reduced = FittingDataReducer::reduce(m_obsTime, m_obsPressure, m_obsDerivative,
+                                                            ui->spinPointsPerCycle->value(),
+                                                            (FittingDataReducer::Statistic)ui->comboReduceStat->currentIndex());
+    m_fitTime = reduced.time;
+    m_fitPressure = reduced.pressure;
+    m_fitDerivative = reduced.derivative;
+    m_fitWeight = reduced.weight;
+}
+
 /**
  * @brief 停止拟合按钮点击
  */
@@ -589,9 +635,29 @@ void FittingWidget::on_btnExportChart_clicked() {
 
 /**
  * @brief 运行优化任务的入口函数
+ * 说明：差分进化单独完成拟合；启用多起点搜索时先由全局搜索确定初值，再从该初值出发做完整的 LM 拟合。
+ * @param starts 多起点搜索的起点数，或差分进化的种群规模
  */
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
+void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, bool useBroyden, FitEngine engine, int starts) {
+    if(engine == FitDifferentialEvolution) {
+        runDifferentialEvolutionOptimization(modelType, fitParams, weight, starts);
+        return;
+    }
+    if(engine == FitMultiStartLM) {
+        QVector<int> fitIndices;
+        for(int i=0; i<fitParams.size(); ++i) {
+            if(fitParams[i].isFit) fitIndices.append(i);
+        }
+        if(!fitIndices.isEmpty()) {
+            QMap<QString, double> best = runMultiStartSearch(modelType, fitParams, fitIndices, weight, useBroyden, starts);
+            if(m_stopRequested) {
+                QMetaObject::invokeMethod(this, "onFitFinished");
+                return;
+            }
+            for(int idx : fitIndices) fitParams[idx].value = best.value(fitParams[idx].name, fitParams[idx].value);
+        }
+    }
+    runLevenbergMarquardtOptimization(modelType, fitParams, weight, useBroyden);
 }
 
 /**
@@ -599,10 +665,10 @@ void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList
  * @param modelType 模型类型
  * @param params 参数列表
  * @param weight 权重 (0~1)
+ * @param useBroyden 是否在迭代间用 Broyden 秩一更新代替雅可比矩阵的完整计算
  */
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    // 设置模型计算为低精度模式以提高迭代速度
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
+void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, bool useBroyden) {
+    // 迭代过程中的模型计算均使用低精度模式以提高速度 (按调用传递，不修改共享状态)
 
     // 1. 确定需要拟合的参数索引
     QVector<int> fitIndices;
@@ -617,38 +683,237 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
         return;
     }
 
-    // 2. 初始化算法参数
+    // 2. 构建参数映射表，迭代至收敛 (最多 50 次) 并在界面上显示迭代过程
+    QMap<QString, double> currentParamMap;
+    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
+    double mse = runLevenbergMarquardtSession(modelType, params, fitIndices, currentParamMap, weight, useBroyden, 50, true);
+
+    // 3. 拟合结束处理
+    // 使用高精度模式计算最终曲线
+    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
+        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
+
+    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
+    emit sigIterationUpdated(mse, currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+
+    // 通知主线程完成
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
+
+/**
+ * @brief 差分进化 (DE/rand/1/bin) 拟合
+ * 说明：每个拟合参数在与 LM 相同的空间中搜索 (对数敏感参数用 log10，其余为线性)，范围为参数上下限。
+ *       初始种群为拉丁超立方样本加参数表当前值；每一代先串行生成全部试验向量，
+ *       再作为一个参数块批量计算其曲线 (全部个体与时间点在模型线程池中一次并行)，逐个与父代比较取优。
+ *       缩放因子 F 每代在 [0.5, 1.0) 内随机抖动，交叉概率 CR = 0.9 以适应参数间的相关性。
+ *       达到最大代数、种群误差收拢或均方误差足够小时结束；最优个体改善时刷新界面曲线。
+ * @param populationSize 种群规模 (不少于 4)
+ */
+void FittingWidget::runDifferentialEvolutionOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, int populationSize) {
+    // 1. 确定需要拟合的参数及其搜索空间
+    QVector<int> fitIndices;
+    for(int i=0; i<params.size(); ++i) {
+        if(params[i].isFit) fitIndices.append(i);
+    }
+    int nParams = fitIndices.size();
+    if(nParams == 0) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
+    }
+
+    QStringList names;
+    QVector<bool> isLog(nParams);
+    QVector<double> lo(nParams), hi(nParams);
+    for(int j=0; j<nParams; ++j) {
+        const FitParameter& p = params[fitIndices[j]];
+        names.append(p.name);
+        isLog[j] = isLogParameter(p);
+        lo[j] = isLog[j] ? log10(p.min) : p.min;
+        hi[j] = isLog[j] ? log10(p.max) : p.max;
+        if(hi[j] < lo[j]) std::swap(lo[j], hi[j]);
+    }
+
+    QMap<QString, double> base;
+    for(const auto& p : params) base.insert(p.name, p.value);
+
+    // 搜索空间坐标 -> 参数映射表 (含 LfD 联动)；按值捕获，并行调用时只做只读访问
+    auto decode = [base, names, isLog](const QVector<double>& x) {
+        QMap<QString, double> m = base;
+        for(int j=0; j<names.size(); ++j) m[names[j]] = isLog[j] ? pow(10.0, x[j]) : x[j];
+        if(m.contains("L") && m.contains("Lf") && m["L"] > 1e-9) m["LfD"] = m["Lf"] / m["L"];
+        return m;
+    };
+    // 一组个体作为一个参数块批量计算 (每个拟合参数一列)，再逐个求均方误差；模型计算失败时视为极大误差
+    QMap<QString, double> batchBase = base;
+    if(batchBase.contains("L") && batchBase.contains("Lf") && batchBase["L"] > 1e-9)
+        batchBase["LfD"] = batchBase["Lf"] / batchBase["L"];
+    auto evaluate = [&](const QVector<QVector<double>>& xs, QVector<double>& out) {
+        out.fill(1e15, xs.size());
+        if(m_fitTime.isEmpty()) return;
+
+        ParameterBatch batch;
+        batch.base = batchBase;
+        for(int j=0; j<nParams; ++j) {
+            QVector<double> column(xs.size());
+            for(int i=0; i<xs.size(); ++i) column[i] = isLog[j] ? pow(10.0, xs[i][j]) : xs[i][j];
+            batch.setColumn(names[j], column);
+        }
+        BatchCurveData curves = m_modelManager->calculateTheoreticalCurves(modelType, batch, m_fitTime, false, &m_stopRequested);
+        if(m_stopRequested) return;
+
+        int n = curves.t.size();
+        for(int i=0; i<xs.size(); ++i) {
+            QVector<double> r = residualsFromCurve(curves.pressureOf(i), curves.derivativeOf(i), n, weight);
+            if(r.isEmpty()) continue;
+            double mse = calculateSumSquaredError(r) / r.size();
+            if(std::isfinite(mse)) out[i] = mse;
+        }
+    };
+
+    // 2. 初始种群: 参数表当前值 + 拉丁超立方样本
+    const int maxGenerations = 200;
+    const double crossover = 0.9;
+    int np = qMax(4, populationSize);
+
+    QVector<QVector<double>> pop;
+    QVector<QMap<QString, double>> starts;
+    starts.append(base);
+    starts += latinHypercubeStarts(params, fitIndices, base, np - 1);
+    for(const auto& m : starts) {
+        QVector<double> x(nParams);
+        for(int j=0; j<nParams; ++j) {
+            double v = m.value(names[j]);
+            v = (isLog[j] && v > 0.0) ? log10(v) : v;
+            x[j] = qMax(lo[j], qMin(v, hi[j]));
+        }
+        pop.append(x);
+    }
+
+    QVector<double> fitness;
+    evaluate(pop, fitness);
+    int best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+
+    auto report = [&]() {
+        QMap<QString, double> m = decode(pop[best]);
+        ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, m, QVector<double>(), false);
+        emit sigIterationUpdated(fitness[best], m, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    };
+    report();
+
+    // 3. 逐代进化
+    QRandomGenerator rng(20240601u);
+    for(int gen = 0; gen < maxGenerations; ++gen) {
+        if(m_stopRequested) break;
+        if(fitness[best] < 3e-3) break; // 与 LM 相同的收敛判据
+
+        // 种群误差已收拢 (最差与最优相差不足 0.1%)，继续进化意义不大
+        // 全部个体计算失败 (误差均为 1e15) 时不是收拢，继续进化
+        double worst = *std::max_element(fitness.begin(), fitness.end());
+        if(fitness[best] < 1e15 && worst - fitness[best] <= 1e-3 * fitness[best]) break;
+
+        emit sigProgress(gen * 100 / maxGenerations);
+
+        double F = 0.5 + 0.5 * rng.generateDouble();
+        QVector<QVector<double>> trials(np);
+        for(int i=0; i<np; ++i) {
+            int a, b, c;
+            do { a = rng.bounded(np); } while(a == i);
+            do { b = rng.bounded(np); } while(b == i || b == a);
+            do { c = rng.bounded(np); } while(c == i || c == a || c == b);
+
+            QVector<double> trial = pop[i];
+            int jRand = rng.bounded(nParams);
+            for(int j=0; j<nParams; ++j) {
+                if(j != jRand && rng.generateDouble() >= crossover) continue;
+                double v = pop[a][j] + F * (pop[b][j] - pop[c][j]);
+                // 越界时取父代与边界的中点，保持在可行域内
+                if(v < lo[j]) v = 0.5 * (lo[j] + pop[i][j]);
+                else if(v > hi[j]) v = 0.5 * (hi[j] + pop[i][j]);
+                trial[j] = v;
+            }
+            trials[i] = trial;
+        }
+
+        QVector<double> trialFitness;
+        evaluate(trials, trialFitness);
+        if(m_stopRequested) break; // 本代计算被取消，结果不完整
+
+        double previousBestFitness = fitness[best];
+        for(int i=0; i<np; ++i) {
+            if(trialFitness[i] <= fitness[i]) {
+                pop[i] = trials[i];
+                fitness[i] = trialFitness[i];
+                if(fitness[i] < fitness[best]) best = i;
+            }
+        }
+        if(fitness[best] < previousBestFitness) report();
+    }
+
+    // 4. 拟合结束处理: 使用高精度模式计算最优个体的曲线
+    QMap<QString, double> finalParams = decode(pop[best]);
+    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, finalParams);
+    emit sigIterationUpdated(fitness[best], finalParams, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
+
+/**
+ * @brief 一次 LM 迭代过程
+ * 说明：从 currentParamMap 出发最多迭代 maxIter 次，结束时 currentParamMap 为迭代得到的参数。
+ *       不访问界面控件，可在多个线程中同时运行；reportProgress 为 false 时不发送界面更新信号。
+ * @return 最终的均方误差 (SSE / 残差个数)
+ */
+double FittingWidget::runLevenbergMarquardtSession(ModelManager::ModelType modelType, const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                                   QMap<QString, double>& currentParamMap, double weight, bool useBroyden, int maxIter, bool reportProgress) {
+    int nParams = fitIndices.size();
+
+    // 1. 初始化算法参数
     double lambda = 0.01;      // 阻尼因子 (initial damping factor)
-    int maxIter = 50;          // 最大迭代次数
     double currentSSE = 1e15;  // 当前误差平方和 (Sum Squared Error)
 
-    // 构建参数映射表
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
+    // Broyden 模式: 连续秩一更新达到上限、或误差相对下降量低于阈值时，下一次迭代重新完整计算雅可比矩阵
+    const int maxBroydenUpdates = 5;
+    const double minBroydenGain = 1e-3;
+    int broydenUpdates = 0;    // 自上次完整计算以来的秩一更新次数
+    QVector<QVector<double>> J;
+
+    // 对数域参数的初值不低于下限，保证可以取对数
+    for(int pIdx : fitIndices) {
+        const FitParameter& p = params[pIdx];
+        if(isLogParameter(p) && currentParamMap.value(p.name) < p.min) currentParamMap[p.name] = p.min;
+    }
 
     // 初始参数联动处理 (LfD = Lf / L)
     if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
         currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
 
-    // 3. 计算初始状态的残差和误差
+    // 2. 计算初始状态的残差和误差
     QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
+    if(residuals.isEmpty()) return currentSSE; // 没有可用残差时返回初始的极大误差
     currentSSE = calculateSumSquaredError(residuals);
 
     // 通知界面更新初始状态
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    if(reportProgress) {
+        ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap, QVector<double>(), false);
+        emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    }
 
-    // 4. 迭代主循环
+    // 3. 迭代主循环
     for(int iter = 0; iter < maxIter; ++iter) {
         if(m_stopRequested) break; // 响应用户停止请求
 
         // 收敛判据：如果均方误差足够小，提前结束
         if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
 
-        emit sigProgress(iter * 100 / maxIter);
+        if(reportProgress) emit sigProgress(iter * 100 / maxIter);
 
         // 计算雅可比矩阵 J (size: nResiduals x nParams)
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
+        // Broyden 模式下沿用上一次迭代更新后的 J，仅在首次迭代或需要刷新时完整计算
+        if(!useBroyden || J.isEmpty() || broydenUpdates >= maxBroydenUpdates) {
+            J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
+            if(m_stopRequested) break; // 停止时雅可比矩阵计算被中途取消，结果不完整
+            broydenUpdates = 0;
+        }
         int nRes = residuals.size();
 
         // 构造正规方程的近似 Hessian 矩阵 H = J^T * J 和 梯度向量 g = J^T * r
@@ -673,8 +938,9 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
         }
 
         bool stepAccepted = false;
+        double lambdaBeforeTries = lambda;
 
-        // 5. 内部循环：尝试更新步长 (Levenberg-Marquardt 核心步骤)
+        // 4. 内部循环：尝试更新步长 (Levenberg-Marquardt 核心步骤)
         // 如果新误差变大，则增大阻尼因子 lambda 并重试
         for(int tryIter=0; tryIter<5; ++tryIter) {
             QVector<QVector<double>> H_lm = H;
@@ -692,14 +958,16 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
             QVector<double> delta = solveLinearSystem(H_lm, negG);
 
             // 计算试探性新参数
+            // dx 记录约束截断后实际的参数变化量 (与 delta 同处对数/线性空间)，供 Broyden 更新使用
             QMap<QString, double> trialMap = currentParamMap;
+            QVector<double> dx(nParams, 0.0);
             for(int i=0; i<nParams; ++i) {
                 int pIdx = fitIndices[i];
                 QString pName = params[pIdx].name;
                 double oldVal = currentParamMap[pName];
 
                 // 判断参数是否需要在对数域更新 (大部分试井参数如 k, C, S 为对数敏感，但 S 和 nf 除外)
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
+                bool isLog = isLogParameter(params[pIdx]);
                 double newVal;
 
                 if(isLog) {
@@ -714,6 +982,7 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
                 // 强制约束参数范围 (Min/Max)
                 newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
                 trialMap[pName] = newVal;
+                dx[i] = (isLog && newVal > 0.0) ? log10(newVal) - log10(oldVal) : newVal - oldVal;
             }
 
             // 参数联动更新
@@ -724,9 +993,17 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
             QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
             double newSSE = calculateSumSquaredError(newRes);
 
-            // 6. 评估更新结果
+            // 5. 评估更新结果
             if(newSSE < currentSSE) {
                 // 成功：接受新参数，减小阻尼因子，进入下一次迭代
+                if(useBroyden) {
+                    QVector<double> dr(nRes);
+                    for(int k=0; k<nRes; ++k) dr[k] = newRes[k] - residuals[k];
+                    broydenUpdate(J, dx, dr);
+                    ++broydenUpdates;
+                    // 误差几乎不再下降时近似雅可比可能已失准，下一次迭代重新完整计算
+                    if(currentSSE - newSSE < minBroydenGain * currentSSE) broydenUpdates = maxBroydenUpdates;
+                }
                 currentSSE = newSSE;
                 currentParamMap = trialMap;
                 residuals = newRes;
@@ -734,8 +1011,10 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
                 stepAccepted = true;
 
                 // 刷新界面曲线
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
+                if(reportProgress) {
+                    ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap, QVector<double>(), false);
+                    emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
+                }
                 break;
             } else {
                 // 失败：误差增加，拒绝更新，增大阻尼因子重试
@@ -743,55 +1022,207 @@ void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType mo
             }
         }
 
+        // Broyden 更新得到的 J 无法给出下降方向时，先用完整计算的 J 重试，不据此判断收敛
+        if(!stepAccepted && broydenUpdates > 0) {
+            broydenUpdates = maxBroydenUpdates;
+            lambda = lambdaBeforeTries;
+            continue;
+        }
+
         // 如果 lambda 过大仍无法下降，认为已陷入局部极小值，终止
         if(!stepAccepted && lambda > 1e10) break;
     }
 
-    // 7. 拟合结束处理
-    // 恢复高精度模式并计算最终曲线
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
+    return currentSSE / residuals.size();
+}
 
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
+/**
+ * @brief 多起点全局搜索
+ * 说明：在参数上下限内按拉丁超立方抽取 starts 个起点 (另加参数表当前值)，
+ *       在模型线程池中并行地从各起点做少量 LM 迭代，按均方误差排序后返回最优者。
+ *       各次迭代共享停止标志，点击停止后尚未开始的起点不再计算。
+ * @return 最优候选的参数映射表
+ */
+QMap<QString, double> FittingWidget::runMultiStartSearch(ModelManager::ModelType modelType, const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                                         double weight, bool useBroyden, int starts) {
+    const int sessionIterations = 8;  // 每个起点的 LM 迭代次数 (只求进入正确的吸引域，不求收敛)
+
+    QMap<QString, double> base;
+    for(const auto& p : params) base.insert(p.name, p.value);
+
+    QVector<QMap<QString, double>> candidates;
+    candidates.append(base);
+    candidates += latinHypercubeStarts(params, fitIndices, base, starts);
+
+    // 各线程只写入自己的元素 (先取得独占的数据指针，避免并行访问时触发隐式共享的分离)
+    QVector<double> mse(candidates.size(), 1e15);
+    QMap<QString, double>* candidateData = candidates.data();
+    double* mseData = mse.data();
+    int total = candidates.size();
+    std::atomic<int> done(0);
+    ParallelFor::run(total, [&](int i) {
+        mseData[i] = runLevenbergMarquardtSession(modelType, params, fitIndices, candidateData[i], weight, useBroyden, sessionIterations, false);
+        emit sigProgress(++done * 100 / total);
+    }, &m_stopRequested);
+
+    // 按均方误差排序，保留最优的候选
+    QVector<int> order(candidates.size());
+    for(int i=0; i<order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&mse](int a, int b) { return mse[a] < mse[b]; });
+
+    return candidates[order[0]];
+}
 
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+/**
+ * @brief 拉丁超立方抽样生成起点
+ * 说明：每个拟合参数的取值范围等分为 count 层，每层恰好取一个点，各参数的层次顺序独立随机排列。
+ *       对数敏感参数 (下限为正且不是 S、nf) 在 log10 空间分层，其余参数在线性空间分层。
+ *       使用固定种子，相同设置下重复拟合得到相同的起点。
+ */
+QVector<QMap<QString, double>> FittingWidget::latinHypercubeStarts(const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                                                   const QMap<QString, double>& base, int count) {
+    QVector<QMap<QString, double>> starts(count, base);
+    QRandomGenerator rng(20240601u);
+
+    for(int pIdx : fitIndices) {
+        const FitParameter& p = params[pIdx];
+        if(!(p.max > p.min)) continue;
+        bool isLog = isLogParameter(p);
+        double lo = isLog ? log10(p.min) : p.min;
+        double hi = isLog ? log10(p.max) : p.max;
+
+        QVector<int> strata(count);
+        for(int k=0; k<count; ++k) strata[k] = k;
+        for(int k=count-1; k>0; --k) std::swap(strata[k], strata[rng.bounded(k + 1)]);
+
+        for(int k=0; k<count; ++k) {
+            double u = (strata[k] + rng.generateDouble()) / count;
+            double v = lo + u * (hi - lo);
+            starts[k][p.name] = isLog ? pow(10.0, v) : v;
+        }
+    }
+    return starts;
+}
 
-    // 通知主线程完成
-    QMetaObject::invokeMethod(this, "onFitFinished");
+/**
+ * @brief 启动快速匹配
+ * 说明：以参数表当前值作为基础参数 (phi、mu、Ct 等用于换算拟合点，其余作为未匹配参数的取值)，
+ *       在后台线程中完成匹配与修正，期间与拟合一样禁用“开始拟合”，可点击停止。
+ */
+void FittingWidget::startQuickMatch() {
+    if(m_isFitting || !m_modelManager || m_obsTime.isEmpty()) return;
+
+    m_paramChart->updateParamsFromTable();
+    QMap<QString, double> base;
+    for(const auto& p : m_paramChart->getParameters()) base.insert(p.name, p.value);
+    if(base.contains("L") && base.contains("Lf") && base["L"] > 1e-9)
+        base["LfD"] = base["Lf"] / base["L"];
+
+    prepareFittingData();
+    m_isFitting = true;
+    m_stopRequested = false;
+    ui->btnRunFit->setEnabled(false);
+
+    QVector<double> t = m_obsTime;
+    QVector<double> d = m_obsDerivative;
+    double w = ui->sliderWeight->value() / 100.0;
+    (void)QtConcurrent::run([this, t, d, base, w](){
+        runQuickMatchTask(t, d, base, w);
+    });
+}
+
+/**
+ * @brief 快速匹配的后台部分
+ * 说明：样板曲线库给出形状最接近的若干候选 (不同模型或网格节点)，每个候选只对匹配得到的连续参数
+ *       (nf 除外) 做少量 LM 迭代，参数范围按参数表的默认规则取匹配值的 0.01 ~ 100 倍。
+ *       各候选在模型线程池中并行修正，按修正后的均方误差排序。
+ */
+void FittingWidget::runQuickMatchTask(const QVector<double>& t, const QVector<double>& d, const QMap<QString, double>& base, double weight) {
+    const int candidateCount = 5;     // 提出的候选数
+    const int polishIterations = 6;   // 每个候选的 LM 迭代次数
+
+    QVector<TypeCurveMatch> matches = m_modelManager->matchTypeCurves(t, d, base, candidateCount);
+
+    QVector<QuickMatchResult> results(matches.size());
+    for(int i=0; i<matches.size(); ++i) {
+        results[i].match = matches[i];
+        results[i].params = base;
+        for(auto it = matches[i].params.constBegin(); it != matches[i].params.constEnd(); ++it)
+            results[i].params[it.key()] = it.value();
+        results[i].mse = 1e15;
+    }
+
+    // 各线程只写入自己的元素 (先取得独占的数据指针，避免并行访问时触发隐式共享的分离)
+    QuickMatchResult* resultData = results.data();
+    int total = results.size();
+    std::atomic<int> done(0);
+    ParallelFor::run(total, [&](int i) {
+        QuickMatchResult& r = resultData[i];
+        QList<FitParameter> polishParams;
+        QVector<int> fitIndices;
+        for(auto it = r.params.constBegin(); it != r.params.constEnd(); ++it) {
+            FitParameter p;
+            p.name = it.key();
+            p.value = it.value();
+            p.isFit = r.match.params.contains(p.name) && p.name != "nf" && p.name != "LfD";
+            if(p.value > 0) { p.min = p.value * 0.01; p.max = p.value * 100.0; }
+            else { p.min = 0.0; p.max = 100.0; }
+            p.isVisible = true;
+            if(p.isFit) fitIndices.append(polishParams.size());
+            polishParams.append(p);
+        }
+        r.mse = runLevenbergMarquardtSession(r.match.type, polishParams, fitIndices, r.params, weight, false, polishIterations, false);
+        emit sigProgress(++done * 100 / total);
+    }, &m_stopRequested);
+
+    // 被停止而未修正或修正失败的候选仍为初始值 1e15，不参与排序与采用
+    QVector<QuickMatchResult> polished;
+    for(const QuickMatchResult& r : results) {
+        if(r.mse < 1e15) polished.append(r);
+    }
+    std::stable_sort(polished.begin(), polished.end(),
+                     [](const QuickMatchResult& a, const QuickMatchResult& b) { return a.mse < b.mse; });
+    m_quickMatchResults = polished;
+    m_quickMatchCandidateCount = matches.size();
+    QMetaObject::invokeMethod(this, "onQuickMatchFinished");
 }
 
 /**
  * @brief 计算残差向量
  * @return 包含压力残差和导数残差的向量
  */
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
-    if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
+QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) const {
+    if(!m_modelManager || m_fitTime.isEmpty()) return QVector<double>();
 
-    // 调用模型管理器计算理论曲线
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
+    // 调用模型管理器计算理论曲线 (在抽稀后的拟合数据上计算，每个残差乘以 sqrt(区间权重))
+    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_fitTime, false);
     const QVector<double>& pCal = std::get<1>(res);
     const QVector<double>& dpCal = std::get<2>(res);
+    return residualsFromCurve(pCal.constData(), dpCal.constData(), qMin(pCal.size(), dpCal.size()), weight);
+}
 
+/**
+ * @brief 由拟合时间点上的理论压力与导数 (各 n 个) 计算残差向量
+ */
+QVector<double> FittingWidget::residualsFromCurve(const double* pCal, const double* dpCal, int n, double weight) const {
     QVector<double> r;
     double wp = weight;
     double wd = 1.0 - weight;
 
     // 计算压力残差 (基于对数差，更符合试井双对数图的拟合需求)
-    int count = qMin(m_obsPressure.size(), pCal.size());
+    int count = qMin(m_fitPressure.size(), n);
     for(int i=0; i<count; ++i) {
-        if(m_obsPressure[i] > 1e-10 && pCal[i] > 1e-10)
-            r.append( (log(m_obsPressure[i]) - log(pCal[i])) * wp );
+        if(m_fitPressure[i] > 1e-10 && pCal[i] > 1e-10)
+            r.append( (log(m_fitPressure[i]) - log(pCal[i])) * wp * sqrt(m_fitWeight[i]) );
         else
             r.append(0.0);
     }
 
     // 计算导数残差
-    int dCount = qMin(m_obsDerivative.size(), dpCal.size());
-    dCount = qMin(dCount, count);
+    int dCount = qMin(m_fitDerivative.size(), count);
     for(int i=0; i<dCount; ++i) {
-        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
-            r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd );
+        if(m_fitDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
+            r.append( (log(m_fitDerivative[i]) - log(dpCal[i])) * wd * sqrt(m_fitWeight[i]) );
         else
             r.append(0.0);
     }
@@ -799,54 +1230,74 @@ QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& p
 }
 
 /**
- * @brief 计算雅可比矩阵 (数值微分法)
+ * @brief 计算雅可比矩阵 (前向自动微分)
+ * 说明：一次对偶数计算同时得到理论曲线及其对全部拟合参数的偏导数，
+ *       不再对每个参数做两次中心差分计算，也无需选取差分步长。
+ *       计算在模型专用线程池中并行执行，点击停止后未开始的部分立即取消。
+ *       多起点搜索与快速匹配会在多个线程中同时调用，因此只以 const 方式读取拟合数据。
  * @return J 矩阵
  */
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
+QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) const {
     int nRes = baseResiduals.size();
     int nParams = fitIndices.size();
-    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
+    QVector<QVector<double>> J(nRes, QVector<double>(nParams, 0.0));
+    if(!m_modelManager || m_fitTime.isEmpty()) return J;
 
+    QStringList names;
+    for(int j = 0; j < nParams; ++j) names.append(currentFitParams[fitIndices[j]].name);
+
+    // 理论曲线及其偏导数 (与 calculateResiduals 相同的时间点与精度)
+    QVector<QVector<double>> dP, dDP;
+    ModelCurveData res = m_modelManager->calculateCurveSensitivities(modelType, params, names, m_fitTime, false, dP, dDP, &m_stopRequested);
+    if(m_stopRequested) return J;
+    const QVector<double>& pCal = std::get<1>(res);
+    const QVector<double>& dpCal = std::get<2>(res);
+
+    int count = qMin(m_fitPressure.size(), pCal.size());
+    int dCount = qMin(qMin(m_fitDerivative.size(), dpCal.size()), count);
+    if(count + dCount != nRes) return J;
+
+    double wp = weight;
+    double wd = 1.0 - weight;
     for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j];
-        QString pName = currentFitParams[idx].name;
+        QString pName = names[j];
         double val = params.value(pName);
-        bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
-
-        // 计算中心差分步长 h
-        double h;
-        QMap<QString, double> pPlus = params;
-        QMap<QString, double> pMinus = params;
-
-        if(isLog) {
-            h = 0.01; // 对数域步长
-            double valLog = log10(val);
-            pPlus[pName] = pow(10.0, valLog + h);
-            pMinus[pName] = pow(10.0, valLog - h);
-        } else {
-            h = 1e-4; // 线性域步长
-            pPlus[pName] = val + h;
-            pMinus[pName] = val - h;
-        }
-
-        // 联动更新
-        auto updateDeps = [](QMap<QString,double>& map) { if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9) map["LfD"] = map["Lf"] / map["L"]; };
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
+        bool isLog = isLogParameter(currentFitParams[fitIndices[j]]);
 
-        // 分别计算正向扰动和负向扰动的残差
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
+        // 对数域参数对 log10(x) 求导: dr/d(log10 x) = dr/dx * x * ln10
+        double scale = isLog ? val * log(10.0) : 1.0;
 
-        // 中心差分公式: df/dx = (f(x+h) - f(x-h)) / 2h
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) {
-                J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
-            }
+        // 残差 r = (ln obs - ln cal) * w * sqrt(区间权重)，故 dr/dx = -w * sqrt(区间权重) * (d cal/dx) / cal
+        for(int i=0; i<count; ++i) {
+            if(m_fitPressure[i] > 1e-10 && pCal[i] > 1e-10)
+                J[i][j] = -wp * sqrt(m_fitWeight[i]) * dP[j][i] / pCal[i] * scale;
+        }
+        for(int i=0; i<dCount; ++i) {
+            if(m_fitDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
+                J[count + i][j] = -wd * sqrt(m_fitWeight[i]) * dDP[j][i] / dpCal[i] * scale;
         }
     }
     return J;
 }
 
+/**
+ * @brief Broyden 秩一更新雅可比矩阵
+ * 说明：使更新后的 J 满足割线条件 J*dx = dr (dr 为实际观测到的残差变化)，
+ *       且在与 dx 正交的方向上保持不变。dx 过小时不更新。
+ */
+void FittingWidget::broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& dx, const QVector<double>& dr) {
+    double dxNorm2 = 0.0;
+    for(double v : dx) dxNorm2 += v * v;
+    if(dxNorm2 < 1e-30) return;
+
+    for(int k=0; k<J.size(); ++k) {
+        double Jdx = 0.0;
+        for(int i=0; i<dx.size(); ++i) Jdx += J[k][i] * dx[i];
+        double c = (dr[k] - Jdx) / dxNorm2;
+        for(int i=0; i<dx.size(); ++i) J[k][i] += c * dx[i];
+    }
+}
+
 /**
  * @brief 求解线性方程组 Ax = b
  * 说明：使用 Eigen 库的 LDLT 分解求解对称正定矩阵，稳定性好。
@@ -917,7 +1368,8 @@ void FittingWidget::updateModelCurve() {
         for(double e = -4; e <= 4; e += 0.1) targetT.append(pow(10, e));
     }
 
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
+    // 预览优先查样板曲线库，超出曲线库范围时回退到内核计算
+    ModelCurveData res = m_modelManager->calculatePreviewCurve(type, currentParams, targetT);
     // 直接复用 onIterationUpdate 来刷新界面
     onIterationUpdate(0, currentParams, std::get<0>(res), std::get<1>(res), std::get<2>(res));
 }
@@ -954,6 +1406,53 @@ void FittingWidget::onFitFinished() {
     QMessageBox::information(this, "完成", "拟合完成。");
 }
 
+/**
+ * @brief 快速匹配完成槽函数
+ * 说明：切换到最优候选的模型并写入其参数 (参数值超出原上下限时按默认规则重设上下限)，
+ *       再列出全部候选供参考；没有样板曲线库或数据不足 (未提出候选) 时不提示，
+ *       只有提出了候选但全部修正失败时才给出警告。
+ */
+void FittingWidget::onQuickMatchFinished() {
+    m_isFitting = false;
+    ui->btnRunFit->setEnabled(true);
+    // 用户已停止：不采用任何候选，保持参数表不变
+    if(m_stopRequested) return;
+    if(m_quickMatchResults.isEmpty()) {
+        if(m_quickMatchCandidateCount > 0)
+            QMessageBox::warning(this, "快速匹配", "没有修正成功的候选模型。");
+        return;
+    }
+
+    const QuickMatchResult& best = m_quickMatchResults.first();
+    m_paramChart->switchModel(best.match.type);
+    m_currentModelType = best.match.type;
+    ui->btn_modelSelect->setText("当前: " + ModelManager::getModelTypeName(m_currentModelType));
+
+    QList<FitParameter> params = m_paramChart->getParameters();
+    for(auto& p : params) {
+        if(!best.params.contains(p.name)) continue;
+        p.value = best.params[p.name];
+        if(p.value < p.min || p.value > p.max) {
+            if(p.value > 0) { p.min = p.value * 0.01; p.max = p.value * 100.0; }
+            else { p.min = 0.0; p.max = 100.0; }
+        }
+    }
+    m_paramChart->setParameters(params);
+    updateModelCurve();
+
+    QString summary;
+    for(int i=0; i<m_quickMatchResults.size(); ++i) {
+        const QuickMatchResult& r = m_quickMatchResults[i];
+        summary += QString("%1. %2  形状偏差 %3  修正后误差(MSE) %4\n")
+                       .arg(i + 1)
+                       .arg(ModelManager::getModelTypeName(r.match.type))
+                       .arg(r.match.distance, 0, 'f', 3)
+                       .arg(r.mse, 0, 'e', 3);
+    }
+    QMessageBox::information(this, "快速匹配",
+                             "按导数形状匹配的候选模型:\n\n" + summary + "\n已采用第 1 个候选，可继续点击“开始拟合”精细拟合。");
+}
+
 /**
  * @brief 绘制图表曲线
  */
@@ -1105,6 +1604,12 @@ QJsonObject FittingWidget::getJsonState() const
     root["modelType"] = (int)m_currentModelType;
     root["modelName"] = ModelManager::getModelTypeName(m_currentModelType);
     root["fitWeightVal"] = ui->sliderWeight->value();
+    root["fitBroyden"] = ui->chkBroyden->isChecked();
+    root["fitPointsPerCycle"] = ui->spinPointsPerCycle->value();
+    root["fitReduceStat"] = ui->comboReduceStat->currentIndex();
+    root["fitGlobalSearch"] = ui->comboGlobalSearch->currentIndex();
+    root["fitStarts"] = ui->spinStarts->value();
+    root["fitQuickMatch"] = ui->chkQuickMatch->isChecked();
 
     QJsonObject plotRange;
     plotRange["xMin"] = m_plot->xAxis->range().lower;
@@ -1187,6 +1692,20 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         double w = root["fitWeight"].toDouble();
         ui->sliderWeight->setValue((int)(w * 100));
     }
+    if (root.contains("fitBroyden")) {
+        ui->chkBroyden->setChecked(root["fitBroyden"].toBool());
+    }
+    if (root.contains("fitPointsPerCycle")) {
+        ui->spinPointsPerCycle->setValue(root["fitPointsPerCycle"].toInt());
+        ui->comboReduceStat->setCurrentIndex(root["fitReduceStat"].toInt());
+    }
+    if (root.contains("fitGlobalSearch")) {
+        ui->comboGlobalSearch->setCurrentIndex(root["fitGlobalSearch"].toInt());
+        ui->spinStarts->setValue(root["fitStarts"].toInt());
+    }
+    if (root.contains("fitQuickMatch")) {
+        ui->chkQuickMatch->setChecked(root["fitQuickMatch"].toBool());
+    }
 
     if (root.contains("observedData")) {
         QJsonObject obs = root["observedData"].toObject();
@@ -1199,7 +1718,7 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         for(auto v : pArr) p.append(v.toDouble());
         for(auto v : dArr) d.append(v.toDouble());
 
-        setObservedData(t, p, d);
+        applyObservedData(t, p, d);
     }
 
     updateModelCurve();
@@ -17,6 +17,7 @@
 #include <QFutureWatcher>
 #include <QJsonObject>
 #include <QStandardItemModel>
+#include <atomic>
 #include "modelmanager.h"
 #include "mousezoom.h"
 #include "chartsetting1.h"
@@ -113,6 +114,9 @@ private slots:
     // 内部逻辑槽：处理拟合完成后的收尾工作
     void onFitFinished();
 
+    // 内部逻辑槽：快速匹配结束后采用最优候选并列出各候选
+    void onQuickMatchFinished();
+
     // 内部逻辑槽：处理权重滑块数值变更
     void onSliderWeightChanged(int value);
 
@@ -132,9 +136,24 @@ private:
     QVector<double> m_obsPressure;         // 观测压力（修改：现存储实测压力）
     QVector<double> m_obsDerivative;       // 观测导数
 
+    // 拟合用数据 (开始拟合时由观测数据按对数时间抽稀得到，拟合线程只读取这些数据)
+    QVector<double> m_fitTime;
+    QVector<double> m_fitPressure;
+    QVector<double> m_fitDerivative;
+    QVector<double> m_fitWeight;           // 各拟合点的区间权重 (平均值为 1)
+
+    // 快速匹配结果 (拟合线程写入，onQuickMatchFinished 在界面线程读取)
+    struct QuickMatchResult {
+        TypeCurveMatch match;              // 样板曲线匹配得到的模型与参数
+        QMap<QString, double> params;      // 短 LM 修正后的参数
+        double mse;                        // 修正后的均方误差
+    };
+    QVector<QuickMatchResult> m_quickMatchResults;
+    int m_quickMatchCandidateCount;        // 样板曲线匹配提出的候选数 (修正筛选前)
+
     // 拟合任务控制状态
     bool m_isFitting;                      // 是否正在拟合中
-    bool m_stopRequested;                  // 是否收到了停止请求
+    std::atomic<bool> m_stopRequested;     // 是否收到了停止请求 (界面线程写入，拟合线程与模型计算读取)
     QFutureWatcher<void> m_watcher;        // 异步任务监视器
 
     // 初始化绘图控件的样式和布局
@@ -146,17 +165,56 @@ private:
     // 根据当前参数表的值，计算并更新理论曲线
     void updateModelCurve();
 
-    // 启动非线性回归优化任务（在子线程运行）
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
+    // 保存观测数据并绘图 (不触发快速匹配，供恢复项目状态使用)
+    void applyObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d);
+
+    // 按界面上的抽稀设置由观测数据生成拟合用数据
+    void prepareFittingData();
+
+    // 快速匹配：按实测导数形状在样板曲线库中找出最接近的若干模型与参数，
+    // 各候选在后台并行做短 LM 修正后取误差最小者 (没有样板曲线库时不做任何事)
+    void startQuickMatch();
+    void runQuickMatchTask(const QVector<double>& t, const QVector<double>& d, const QMap<QString, double>& base, double weight);
+
+    // 拟合算法 (序号与界面上全局搜索下拉框的选项一致)
+    enum FitEngine {
+        FitLevenbergMarquardt = 0,     // 从参数表当前值出发的 LM
+        FitMultiStartLM = 1,           // 多起点搜索后再做 LM
+        FitDifferentialEvolution = 2   // 差分进化
+    };
+
+    // 启动非线性回归优化任务（在子线程运行），starts 为多起点搜索的起点数或差分进化的种群规模
+    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, bool useBroyden, FitEngine engine, int starts);
 
-    // Levenberg-Marquardt 算法的具体实现
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
+    // Levenberg-Marquardt 算法的具体实现 (useBroyden 为 true 时雅可比矩阵在迭代间做 Broyden 秩一更新)
+    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, bool useBroyden);
+
+    // 差分进化算法的具体实现 (每一代的个体并行计算)
+    void runDifferentialEvolutionOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, int populationSize);
+
+    // 一次 LM 迭代过程 (可在多个线程中同时运行)，返回最终的均方误差
+    double runLevenbergMarquardtSession(ModelManager::ModelType modelType, const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                        QMap<QString, double>& currentParamMap, double weight, bool useBroyden, int maxIter, bool reportProgress);
+
+    // 多起点全局搜索：并行地从各起点做少量 LM 迭代，返回误差最小的参数
+    QMap<QString, double> runMultiStartSearch(ModelManager::ModelType modelType, const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                              double weight, bool useBroyden, int starts);
+
+    // 在拟合参数上下限内按拉丁超立方抽样生成 count 个起点 (未拟合的参数取 base 中的值)
+    static QVector<QMap<QString, double>> latinHypercubeStarts(const QList<FitParameter>& params, const QVector<int>& fitIndices,
+                                                               const QMap<QString, double>& base, int count);
 
     // 计算当前参数下的残差向量（理论值与观测值的差异）
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
+    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) const;
+
+    // 由拟合时间点上已算好的理论压力与导数 (各 n 个) 计算残差向量 (供批量计算使用)
+    QVector<double> residualsFromCurve(const double* pCal, const double* dpCal, int n, double weight) const;
 
     // 计算雅可比矩阵（残差对各个待拟合参数的偏导数）
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
+    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) const;
+
+    // Broyden 秩一更新: J += (dr - J*dx) dx^T / (dx^T dx)，dx 与 LM 步长处于同一 (对数/线性) 参数空间
+    static void broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& dx, const QVector<double>& dr);
 
     // 求解线性方程组 (Ax = b)，用于LM算法中的迭代步长计算
     QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
@@ -5,6 +5,7 @@
  * 1. [核心修改] 实现了数据点的完整序列化与反序列化，支持保存至独立JSON文件。
  * 2. 实现了从文件恢复图表的功能 (loadProjectData)。
  * 3. 保持了原有的绘图、分析、交互逻辑。
+ * 4. 叠加导数分析：由压力产量曲线的产量历史计算等效时间导数 (SuperpositionTime)。
  */
 
 #include "wt_plottingwidget.h"
@@ -18,6 +19,9 @@
 #include "chartsetting1.h"
 #include "chartsetting2.h"
 #include "modelparameter.h"
+#include "pressurederivativecalculator.h"
+#include "derivativesmoother.h"
+#include "superpositiontime.h"
 
 #include <QMessageBox>
 #include <QFileDialog>
@@ -72,6 +76,7 @@ QJsonObject CurveInfo::toJson() const {
         obj["LSpacing"] = LSpacing;
         obj["isSmooth"] = isSmooth;
         obj["smoothFactor"] = smoothFactor;
+        obj["smoothMethod"] = smoothMethod;
         obj["derivData"] = vectorToJson(derivData);
         obj["derivShape"] = (int)derivShape;
         obj["derivPointColor"] = derivPointColor.name();
@@ -113,6 +118,7 @@ CurveInfo CurveInfo::fromJson(const QJsonObject& json) {
         info.LSpacing = json["LSpacing"].toDouble();
         info.isSmooth = json["isSmooth"].toBool();
         info.smoothFactor = json["smoothFactor"].toInt();
+        info.smoothMethod = json["smoothMethod"].toInt(0);
         info.derivData = jsonToVector(json["derivData"].toArray());
         info.derivShape = (QCPScatterStyle::ScatterShape)json["derivShape"].toInt();
         info.derivPointColor = QColor(json["derivPointColor"].toString());
@@ -347,6 +353,7 @@ void WT_PlottingWidget::on_btn_Derivative_clicked()
         info.LSpacing = dlg.getLSpacing();
         info.isSmooth = dlg.isSmoothEnabled();
         info.smoothFactor = dlg.getSmoothFactor();
+        info.smoothMethod = dlg.getSmoothMethod();
 
         double initialP = 0; bool first = true;
         for(int i=0; i<m_dataModel->rowCount(); ++i) {
@@ -359,29 +366,11 @@ void WT_PlottingWidget::on_btn_Derivative_clicked()
 
         if(info.xData.size() < 3) { QMessageBox::warning(this, "错误", "数据点不足"); return; }
 
-        QVector<double> derData;
-        for (int i = 0; i < info.xData.size(); ++i) {
-            double t = info.xData[i];
-            double logT = std::log(t);
-            int l=i, r=i;
-            while(l>0 && std::log(info.xData[l]) > logT - info.LSpacing) l--;
-            while(r<info.xData.size()-1 && std::log(info.xData[r]) < logT + info.LSpacing) r++;
-            double num = info.yData[r] - info.yData[l];
-            double den = std::log(info.xData[r]) - std::log(info.xData[l]);
-            derData.append(std::abs(den)>1e-6 ? num/den : 0);
-        }
+        QVector<double> derData = PressureDerivativeCalculator::calculateBourdetDerivative(info.xData, info.yData, info.LSpacing);
 
         if(info.isSmooth && info.smoothFactor > 1) {
-            QVector<double> smoothed;
-            int half = info.smoothFactor/2;
-            for (int i = 0; i < derData.size(); ++i) {
-                double sum = 0; int cnt = 0;
-                for (int j = i - half; j <= i + half; ++j) {
-                    if (j >= 0 && j < derData.size()) { sum += derData[j]; cnt++; }
-                }
-                smoothed.append(sum / cnt);
-            }
-            info.derivData = smoothed;
+            info.derivData = DerivativeSmoother::smooth(info.xData, derData,
+                                                        (DerivativeSmoother::Method)info.smoothMethod, info.smoothFactor);
         } else {
             info.derivData = derData;
         }
@@ -411,6 +400,69 @@ void WT_PlottingWidget::on_btn_Derivative_clicked()
     }
 }
 
+void WT_PlottingWidget::on_btn_Superposition_clicked()
+{
+    // 以当前显示的压力产量曲线生成叠加导数曲线：分析最后一个压力点所在的流动段 (通常为关井恢复)，
+    // 横坐标为段内时间 Δt，导数为 dΔp / d ln te (te 为按全部产量历史叠加的等效时间)
+    if(!m_curves.contains(m_currentDisplayedCurve) || m_curves[m_currentDisplayedCurve].type != 1) {
+        QMessageBox::warning(this, "提示", "请先显示一条压力产量曲线"); return;
+    }
+    const CurveInfo src = m_curves[m_currentDisplayedCurve];
+    if(src.prodGraphType != 0) {
+        QMessageBox::warning(this, "提示", "叠加导数需要阶梯图格式的产量数据 (各段持续时间与产量)"); return;
+    }
+
+    SuperpositionTime sp = SuperpositionTime::fromDurations(src.x2Data, src.y2Data);
+    if(sp.stepCount() == 0 || src.xData.isEmpty()) { QMessageBox::warning(this, "错误", "产量数据为空"); return; }
+
+    double tEnd = src.xData[0];
+    for(double t : src.xData) tEnd = qMax(tEnd, t);
+    int period = sp.periodOf(tEnd);
+    if(period < 0) { QMessageBox::warning(this, "错误", "压力数据不在产量历史范围内"); return; }
+    double tStart = sp.stepTime(period);
+
+    // 段起点压力：段开始前的最后一个压力点，没有时取段内第一个点
+    int ref = -1;
+    for(int i=0; i<src.xData.size(); ++i) {
+        double t = src.xData[i];
+        if(t <= tStart) {
+            if(ref < 0 || src.xData[ref] > tStart || t >= src.xData[ref]) ref = i;
+        } else if(ref < 0 || (src.xData[ref] > tStart && t < src.xData[ref])) {
+            ref = i;
+        }
+    }
+    double pStart = src.yData[ref];
+
+    QVector<double> tAbs;
+    CurveInfo info;
+    for(int i=0; i<src.xData.size(); ++i) {
+        double t = src.xData[i];
+        double dp = std::abs(src.yData[i] - pStart);
+        if(t > tStart && dp > 0) { tAbs.append(t); info.xData.append(t - tStart); info.yData.append(dp); }
+    }
+    if(info.xData.size() < 3) { QMessageBox::warning(this, "错误", "数据点不足"); return; }
+
+    info.name = src.name + " - 叠加导数";
+    for(int k = 2; m_curves.contains(info.name); ++k) info.name = QString("%1 - 叠加导数 %2").arg(src.name).arg(k);
+    info.legendName = "Pressure";
+    info.prodLegendName = "Superposition Derivative";
+    info.type = 2;
+    info.xCol = src.xCol; info.yCol = src.yCol;
+    info.derivData = sp.derivative(tAbs, info.yData, info.LSpacing);
+
+    info.pointShape = QCPScatterStyle::ssDisc; info.pointColor = Qt::red;
+    info.lineStyle = Qt::NoPen; info.lineColor = Qt::red;
+    info.derivShape = QCPScatterStyle::ssTriangle; info.derivPointColor = Qt::blue;
+    info.derivLineStyle = Qt::NoPen; info.derivLineColor = Qt::blue;
+
+    m_curves.insert(info.name, info);
+    ui->listWidget_Curves->addItem(info.name);
+
+    setupPlotStyle(Mode_Single);
+    drawDerivativePlot(info);
+    m_currentDisplayedCurve = info.name;
+}
+
 // ---------------- 绘图函数 ----------------
 
 void WT_PlottingWidget::addCurveToPlot(const CurveInfo& info)
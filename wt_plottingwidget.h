@@ -40,6 +40,7 @@ struct CurveInfo {
     double LSpacing;
     bool isSmooth;
     int smoothFactor;
+    int smoothMethod; // DerivativeSmoother::Method
 
     QVector<double> derivData; // 缓存
     QCPScatterStyle::ScatterShape derivShape;
@@ -49,7 +50,7 @@ struct CurveInfo {
 
     CurveInfo() : xCol(-1), yCol(-1), x2Col(-1), y2Col(-1),
         pointShape(QCPScatterStyle::ssDisc), type(0), prodGraphType(0),
-        isMeasuredP(true), LSpacing(0.1), isSmooth(false), smoothFactor(3) {}
+        isMeasuredP(true), LSpacing(0.1), isSmooth(false), smoothFactor(3), smoothMethod(0) {}
 
     QJsonObject toJson() const;
     static CurveInfo fromJson(const QJsonObject& json);
@@ -74,6 +75,7 @@ private slots:
     void on_btn_NewCurve_clicked();
     void on_btn_PressureRate_clicked();
     void on_btn_Derivative_clicked();
+    void on_btn_Superposition_clicked();
     void on_btn_Manage_clicked();
     void on_btn_Delete_clicked();
     void on_btn_Save_clicked();